@@ -0,0 +1,146 @@
+/**
+    @file
+    mxd_events.h: time-stamped message queue for sample-accurate events in the wrappers
+
+    Max messages only reach an external between signal vectors. Instead of applying them
+    at the next vector boundary, a wrapper pushes each one here from its message method,
+    stamped with the scheduler time, and pops them in perform64 with a sample offset into
+    the current vector. Events stamped during one vector land at the same relative
+    position in the next, so timing is exact up to a fixed latency of one vector, at any
+    signal vector size.
+
+    usage:
+
+        t_mxd_events events;                                // in the object struct
+        mxd_events_init(&x->events);                        // mxd_new
+        mxd_events_free(&x->events);                        // mxd_free
+        mxd_events_push(&x->events, HIT, voice, accent);    // message method
+        mxd_events_dsp(&x->events, samplerate);             // dsp64
+
+        // perform64: render up to each event, apply it, continue
+        mxd_events_vector(&x->events, sampleframes);
+        t_mxd_event ev;
+        while (mxd_events_pop(&x->events, &ev)) {
+            ... ev.offset, ev.type, ev.index, ev.value
+        }
+*/
+#ifndef MXD_EVENTS_H
+#define MXD_EVENTS_H
+
+#include "ext.h"
+
+#define MXD_EVENTS_SIZE 256
+
+
+typedef struct _mxd_event {
+    double time;                // scheduler time in ms
+    long offset;                // sample offset into the current vector, set by mxd_events_pop
+    long type;                  // meaning defined by the wrapper
+    long index;                 // e.g. a voice
+    double value;               // e.g. an accent
+} t_mxd_event;
+
+
+typedef struct _mxd_events {
+    t_critical lock;            // guards the ring, messages may arrive on the main and scheduler threads
+    t_mxd_event ring[MXD_EVENTS_SIZE];
+    long head;                  // oldest event
+    long count;                 // queued events, sorted by time
+    double samples_per_ms;
+    double vector_start;        // scheduler time mapped to sample 0 of the current vector
+    long vector_size;
+} t_mxd_events;
+
+
+static inline void mxd_events_init(t_mxd_events *q)
+{
+    critical_new(&q->lock);
+    q->head = 0;
+    q->count = 0;
+    q->samples_per_ms = 44.1;
+    q->vector_start = 0.0;
+    q->vector_size = 0;
+}
+
+
+static inline void mxd_events_free(t_mxd_events *q)
+{
+    critical_free(q->lock);
+}
+
+
+// sets the sample rate, call from dsp64
+static inline void mxd_events_dsp(t_mxd_events *q, double samplerate)
+{
+    q->samples_per_ms = samplerate / 1000.0;
+}
+
+
+// queues an event stamped with the current scheduler time,
+// returns false (and drops the event) when the queue is full
+static inline bool mxd_events_push(t_mxd_events *q, long type, long index, double value)
+{
+    double now;
+    scheduler_gettime(&now);
+
+    bool ok = false;
+    critical_enter(q->lock);
+    if (q->count < MXD_EVENTS_SIZE) {
+        // insert in time order, equal times keep their arrival order
+        long i = q->count++;
+        while (i > 0) {
+            t_mxd_event *prev = &q->ring[(q->head + i - 1) % MXD_EVENTS_SIZE];
+            if (prev->time <= now) {
+                break;
+            }
+            q->ring[(q->head + i) % MXD_EVENTS_SIZE] = *prev;
+            i--;
+        }
+        t_mxd_event *ev = &q->ring[(q->head + i) % MXD_EVENTS_SIZE];
+        ev->time = now;
+        ev->offset = 0;
+        ev->type = type;
+        ev->index = index;
+        ev->value = value;
+        ok = true;
+    }
+    critical_exit(q->lock);
+    return ok;
+}
+
+
+// starts a vector, call at the top of perform64
+static inline void mxd_events_vector(t_mxd_events *q, long sampleframes)
+{
+    double now;
+    scheduler_gettime(&now);
+    q->vector_start = now - sampleframes / q->samples_per_ms;
+    q->vector_size = sampleframes;
+}
+
+
+// takes the next event that falls inside the current vector, in time order.
+// Late events get offset 0, later ones wait for their vector. Never blocks:
+// if a message method holds the lock the events are taken one vector late.
+static inline bool mxd_events_pop(t_mxd_events *q, t_mxd_event *ev)
+{
+    if (critical_tryenter(q->lock) != MAX_ERR_NONE) {
+        return false;
+    }
+    bool found = false;
+    if (q->count > 0) {
+        t_mxd_event *head = &q->ring[q->head];
+        double offset = (head->time - q->vector_start) * q->samples_per_ms;
+        if (offset < q->vector_size) {
+            *ev = *head;
+            ev->offset = offset > 0.0 ? (long)offset : 0;
+            q->head = (q->head + 1) % MXD_EVENTS_SIZE;
+            q->count--;
+            found = true;
+        }
+    }
+    critical_exit(q->lock);
+    return found;
+}
+
+#endif
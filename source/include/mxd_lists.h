@@ -0,0 +1,36 @@
+/**
+    @file
+    mxd_lists.h: per-channel parameter lists for the multichannel wrappers
+
+    A single value sets every channel, a list sets channels in order and leaves the
+    rest unchanged.
+
+    usage:
+
+        if (s == gensym("freq")) {
+            mxd_setlist(x->freq, MAX_CHANNELS, argc, argv);
+            x->dirty = true;
+        }
+*/
+#ifndef MXD_LISTS_H
+#define MXD_LISTS_H
+
+#include "ext.h"
+
+
+static inline void mxd_setlist(double *dst, long size, long argc, t_atom *argv)
+{
+    if (argc == 1) {
+        double v = atom_getfloat(argv);
+        for (long i = 0; i < size; ++i) {
+            dst[i] = v;
+        }
+    }
+    else {
+        for (long i = 0; i < argc && i < size; ++i) {
+            dst[i] = atom_getfloat(argv + i);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,35 @@
+/**
+    @file
+    mxd_silence.h: input checks for skipping idle effects in the wrappers
+
+    A decaying effect whose tail has died out (IsSilent()) and whose input is
+    silent would only render zeros, so the wrapper can zero-fill its outputs
+    instead. Only exact zeros and values in the float denormal range count as
+    silent input: anything audible, however quiet, still reaches the effect.
+
+    usage:
+
+        if (x->rev->IsSilent() && mxd_vector_is_silent(inL, n) && mxd_vector_is_silent(inR, n)) {
+            ... zero the outputs and return
+        }
+*/
+#ifndef MXD_SILENCE_H
+#define MXD_SILENCE_H
+
+#include "ext.h"
+#include <cfloat>
+#include <cmath>
+
+
+// true if every sample is zero or below the smallest normal float
+static inline bool mxd_vector_is_silent(const t_double *in, long n)
+{
+    for (long i = 0; i < n; ++i) {
+        if (std::fabs(in[i]) >= FLT_MIN) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif
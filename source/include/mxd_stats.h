@@ -0,0 +1,124 @@
+/**
+    @file
+    mxd_stats.h: per-object perform timing for the wrappers
+
+    Configure with -DDSY_DSP_STATS=ON to give every wrapper a rightmost info outlet
+    and a "stats" message. "stats" sends mean, p99 and max perform time per vector
+    in microseconds, the mean as a percentage of the vector duration and the number
+    of vectors out of that outlet. "stats reset" clears them.
+
+    Without the option every call here compiles to nothing, so the wrappers use it
+    unconditionally.
+
+    usage:
+
+        t_mxd_stats stats;                                      // in the object struct
+        mxd_stats_setup<t_mxd>(c);                              // ext_main
+        mxd_stats_new(&x->stats, (t_object *)x);                // mxd_new, before the signal outlets
+        mxd_stats_free(&x->stats);                              // mxd_free
+        mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);    // dsp64
+        mxd_stats_scope timer(&x->stats);                       // perform64, times until it returns
+*/
+#ifndef MXD_STATS_H
+#define MXD_STATS_H
+
+#include "ext.h"
+#include "ext_obex.h"
+
+#ifdef DSY_DSP_STATS
+#include "cyclestats.h"
+#endif
+
+
+typedef struct _mxd_stats {
+#ifdef DSY_DSP_STATS
+    daisysp::CycleStats *cycles;    // on the heap, object_alloc does not run constructors
+    double vector_seconds;          // duration of one signal vector
+    void *outlet;                   // outlet for the stats message
+#else
+    char unused;
+#endif
+} t_mxd_stats;
+
+
+#ifdef DSY_DSP_STATS
+
+template <typename T>
+static void mxd_stats_message(T *x, t_symbol *s, long argc, t_atom *argv)
+{
+    t_mxd_stats *st = &x->stats;
+    if (argc > 0 && atom_getsym(argv) == gensym("reset")) {
+        st->cycles->Reset();
+        return;
+    }
+
+    double mean = st->cycles->GetMean();
+    t_atom av[5];
+    atom_setfloat(av + 0, mean * 1e6);
+    atom_setfloat(av + 1, st->cycles->GetPercentile(0.99f) * 1e6);
+    atom_setfloat(av + 2, st->cycles->GetMax() * 1e6);
+    atom_setfloat(av + 3, st->vector_seconds > 0 ? 100.0 * mean / st->vector_seconds : 0.0);
+    atom_setlong(av + 4, (t_atom_long)st->cycles->GetCount());
+    outlet_anything(st->outlet, gensym("stats"), 5, av);
+}
+
+
+// T is the object struct, with a t_mxd_stats member named stats
+template <typename T>
+static inline void mxd_stats_setup(t_class *c)
+{
+    class_addmethod(c, (method)mxd_stats_message<T>, "stats", A_GIMME, 0);
+}
+
+
+static inline void mxd_stats_new(t_mxd_stats *st, t_object *x)
+{
+    st->outlet = outlet_new(x, NULL);
+    st->cycles = new daisysp::CycleStats;
+    st->cycles->Init();
+    st->vector_seconds = 0.0;
+}
+
+
+static inline void mxd_stats_free(t_mxd_stats *st)
+{
+    delete st->cycles;
+    st->cycles = NULL;
+}
+
+
+static inline void mxd_stats_dsp(t_mxd_stats *st, double samplerate, long maxvectorsize)
+{
+    st->vector_seconds = maxvectorsize / samplerate;
+    st->cycles->Reset();
+}
+
+
+// times its own lifetime, place at the top of perform64
+class mxd_stats_scope {
+public:
+    explicit mxd_stats_scope(t_mxd_stats *st) : timer_(*st->cycles) {}
+
+private:
+    daisysp::CycleStats::Scope timer_;
+};
+
+#else
+
+template <typename T>
+static inline void mxd_stats_setup(t_class *c) {}
+
+static inline void mxd_stats_new(t_mxd_stats *st, t_object *x) {}
+
+static inline void mxd_stats_free(t_mxd_stats *st) {}
+
+static inline void mxd_stats_dsp(t_mxd_stats *st, double samplerate, long maxvectorsize) {}
+
+class mxd_stats_scope {
+public:
+    explicit mxd_stats_scope(t_mxd_stats *st) {}
+};
+
+#endif
+
+#endif
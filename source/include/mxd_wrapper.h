@@ -0,0 +1,336 @@
+/**
+    @file
+    mxd_wrapper.h: generic Max external around a DaisySP module
+
+    The dsp.*~ externals that only map messages to module setters and call Process
+    per sample are all the same code. This header generates that code from a
+    descriptor: the module type, its signal shape and a table of parameters.
+
+    Each parameter gets
+        - an attribute, so "freq 440" messages and @freq 440 arguments both work
+        - a signal inlet, which also takes floats and ints
+    Values are clamped when set and only passed to the module when they changed,
+    at the start of the next vector.
+
+    perform64 is picked in dsp64 from the connection state. With no parameter
+    inlet connected the module renders the whole vector in one call. With signals
+    connected it renders in runs over which every connected signal is constant,
+    setting the changed parameters between runs, so a stepped or held control
+    signal costs little more than a float.
+
+    usage:
+
+        typedef daisysp::MoogLadderT<double> t_moog;
+
+        struct t_moog_desc : mxd_filter<t_moog> {
+            static const t_mxd_param<t_moog> params[2];
+        };
+
+        const t_mxd_param<t_moog> t_moog_desc::params[2] = {
+            MXD_PARAM(t_moog, SetFreq, "freq", 100.0, 0.0, 20000.0),
+            MXD_PARAM(t_moog, SetRes,  "res",  0.5,   0.0, 1.0),
+        };
+
+        void ext_main(void *r)
+        {
+            mxd_wrapper<t_moog_desc>::setup("dsp.moog~");
+        }
+
+    mxd_source and mxd_filter cover modules with a Process() or Process(in) method
+    and an Init(samplerate). Other shapes derive from them or write their own
+    init and process, with the same signatures.
+*/
+#ifndef MXD_WRAPPER_H
+#define MXD_WRAPPER_H
+
+#include "ext.h"
+#include "ext_obex.h"
+#include "z_dsp.h"
+#include "denormal.h"
+#include "mxd_stats.h"
+
+#include <cstddef>
+#include <type_traits>
+
+
+// one parameter of a wrapped module
+template <typename Module>
+struct t_mxd_param {
+    const char *name;                   // attribute, message and inlet name
+    double init;                        // value until set
+    double min;                         // values are clamped to min..max
+    double max;
+    void (*set)(Module &m, double v);   // passes a value to the module
+};
+
+
+// turns a setter such as void SetFreq(float) into a t_mxd_param setter
+template <typename F, F f>
+struct mxd_param_setter;
+
+template <typename M, typename A, void (M::*f)(A)>
+struct mxd_param_setter<void (M::*)(A), f> {
+    static void set(M &m, double v)
+    {
+        (m.*f)(static_cast<typename std::decay<A>::type>(v));
+    }
+};
+
+#define MXD_PARAM(module, setter, name, init, min, max)                         \
+    {                                                                           \
+        name, init, min, max,                                                   \
+            &mxd_param_setter<decltype(&module::setter), &module::setter>::set  \
+    }
+
+
+// no signal input, one output from Process()
+template <typename Module>
+struct mxd_source {
+    typedef Module module_type;
+    enum { num_inputs = 0, num_outputs = 1 };
+
+    static void init(Module &m, double samplerate)
+    {
+        m.Init(samplerate);
+    }
+
+    // renders samples offset to offset + n - 1 of the vector
+    static void process(Module &m, double **ins, double **outs, long offset, long n)
+    {
+        double *out = outs[0] + offset;
+        for (long i = 0; i < n; ++i) {
+            out[i] = m.Process();
+        }
+    }
+};
+
+
+// one signal input, one output from Process(in)
+template <typename Module>
+struct mxd_filter : mxd_source<Module> {
+    enum { num_inputs = 1, num_outputs = 1 };
+
+    static void process(Module &m, double **ins, double **outs, long offset, long n)
+    {
+        const double *in = ins[0] + offset;
+        double *out = outs[0] + offset;
+        for (long i = 0; i < n; ++i) {
+            out[i] = m.Process(in[i]);
+        }
+    }
+};
+
+
+template <typename Desc>
+struct mxd_wrapper {
+    typedef typename Desc::module_type t_module;
+
+    static const long num_params = sizeof(Desc::params) / sizeof(Desc::params[0]);
+    static const long num_inputs = Desc::num_inputs;
+    static const long num_outputs = Desc::num_outputs;
+
+    typedef struct _mxd {
+        t_pxobject ob;                  // the object itself (t_pxobject in MSP instead of t_object)
+        t_module *module;               // the wrapped daisy module
+        double value[num_params];       // parameter values, set from messages, attributes and floats
+        double applied[num_params];     // values last passed to the module
+        short connected[num_params];    // parameter inlet has a signal
+        t_mxd_stats stats;              // perform64 timing, see mxd_stats.h
+    } t_mxd;
+
+    static t_class *s_class;
+
+
+    // call from ext_main
+    static void setup(const char *name)
+    {
+        t_class *c = class_new(name, (method)mxd_new, (method)mxd_free, (long)sizeof(t_mxd), 0L, A_GIMME, 0);
+
+        class_addmethod(c, (method)mxd_float,    "float",    A_FLOAT,   0);
+        class_addmethod(c, (method)mxd_int,      "int",      A_LONG,    0);
+        class_addmethod(c, (method)mxd_dsp64,    "dsp64",    A_CANT,    0);
+        class_addmethod(c, (method)mxd_assist,   "assist",   A_CANT,    0);
+        mxd_stats_setup<t_mxd>(c);
+        add_attrs(c, std::integral_constant<long, 0>());
+
+        class_dspinit(c);
+        class_register(CLASS_BOX, c);
+        s_class = c;
+    }
+
+
+    static void *mxd_new(t_symbol *s, long argc, t_atom *argv)
+    {
+        t_mxd *x = (t_mxd *)object_alloc(s_class);
+
+        if (x) {
+            dsp_setup((t_pxobject *)x, num_inputs + num_params);
+
+            mxd_stats_new(&x->stats, (t_object *)x);  // rightmost outlet: stats
+            for (long i = 0; i < num_outputs; ++i) {
+                outlet_new(x, "signal");
+            }
+
+            x->module = new t_module;
+            for (long i = 0; i < num_params; ++i) {
+                x->value[i] = Desc::params[i].init;
+                x->connected[i] = 0;
+            }
+            attr_args_process(x, (short)argc, argv);
+        }
+        return (x);
+    }
+
+
+    static void mxd_free(t_mxd *x)
+    {
+        dsp_free((t_pxobject *)x);
+        mxd_stats_free(&x->stats);
+        delete x->module;
+    }
+
+
+    static void mxd_assist(t_mxd *x, void *b, long m, long a, char *s)
+    {
+        if (m == ASSIST_INLET) {
+            if (a < num_inputs) {
+                sprintf(s, "(signal) Input %ld", a + 1);
+            }
+            else {
+                sprintf(s, "(signal/float) %s", Desc::params[a - num_inputs].name);
+            }
+        }
+        else {
+            if (a < num_outputs) {
+                sprintf(s, "(signal) Output %ld", a + 1);
+            }
+            else {
+                sprintf(s, "stats");
+            }
+        }
+    }
+
+
+    // a float into a parameter inlet sets the parameter
+    static void mxd_float(t_mxd *x, double f)
+    {
+        long p = proxy_getinlet((t_object *)x) - num_inputs;
+        if (p >= 0 && p < num_params) {
+            x->value[p] = clamp(p, f);
+        }
+    }
+
+
+    static void mxd_int(t_mxd *x, long i)
+    {
+        mxd_float(x, (double)i);
+    }
+
+
+    static void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags)
+    {
+        Desc::init(*x->module, samplerate);
+
+        // Init resets the module, so every parameter is passed again
+        bool modulated = false;
+        for (long i = 0; i < num_params; ++i) {
+            Desc::params[i].set(*x->module, x->value[i]);
+            x->applied[i] = x->value[i];
+            x->connected[i] = count[num_inputs + i];
+            modulated = modulated || x->connected[i];
+        }
+
+        mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);
+
+        if (modulated) {
+            object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64<true>, 0, NULL);
+        }
+        else {
+            object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64<false>, 0, NULL);
+        }
+    }
+
+
+    template <bool modulated>
+    static void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
+    {
+        daisysp::ScopedFlushDenormals ftz;  // FTZ/DAZ for the duration of the vector
+        mxd_stats_scope timer(&x->stats);  // timed until perform returns
+        t_module &m = *x->module;
+
+        // values set between vectors, only the ones that changed
+        for (long i = 0; i < num_params; ++i) {
+            if (!(modulated && x->connected[i]) && x->value[i] != x->applied[i]) {
+                Desc::params[i].set(m, x->value[i]);
+                x->applied[i] = x->value[i];
+            }
+        }
+
+        if (!modulated) {
+            Desc::process(m, ins, outs, 0, sampleframes);
+            return;
+        }
+
+        double **signals = ins + num_inputs;
+        long n = 0;
+        while (n < sampleframes) {
+            // apply the connected signals at n, then extend the run while none changes
+            for (long i = 0; i < num_params; ++i) {
+                if (x->connected[i] && signals[i][n] != x->applied[i]) {
+                    Desc::params[i].set(m, clamp(i, signals[i][n]));
+                    x->applied[i] = signals[i][n];
+                }
+            }
+            long end = n + 1;
+            while (end < sampleframes && !changes(x, signals, n, end)) {
+                ++end;
+            }
+            Desc::process(m, ins, outs, n, end - n);
+            n = end;
+        }
+    }
+
+
+    static inline bool changes(t_mxd *x, double **signals, long n, long end)
+    {
+        for (long i = 0; i < num_params; ++i) {
+            if (x->connected[i] && signals[i][end] != signals[i][n]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    static inline double clamp(long i, double v)
+    {
+        const t_mxd_param<t_module> &p = Desc::params[i];
+        return v < p.min ? p.min : (v > p.max ? p.max : v);
+    }
+
+
+    // one attribute per parameter, over value[I]
+    template <long I>
+    static t_max_err attr_set(t_mxd *x, void *attr, long argc, t_atom *argv)
+    {
+        if (argc > 0 && argv) {
+            x->value[I] = clamp(I, atom_getfloat(argv));
+        }
+        return MAX_ERR_NONE;
+    }
+
+    template <long I>
+    static void add_attrs(t_class *c, std::integral_constant<long, I>)
+    {
+        long offset = calcoffset(t_mxd, value) + I * sizeof(double);
+        class_addattr(c, attr_offset_new(Desc::params[I].name, gensym("float64"), 0, NULL, (method)attr_set<I>, offset));
+        add_attrs(c, std::integral_constant<long, I + 1>());
+    }
+
+    static void add_attrs(t_class *c, std::integral_constant<long, num_params>) {}
+};
+
+template <typename Desc>
+t_class *mxd_wrapper<Desc>::s_class = NULL;
+
+#endif
@@ -1,5 +1,6 @@
 #include "adsr.h"
 #include <math.h>
+#include "profile.h"
 
 using namespace daisysp;
 
@@ -50,6 +51,7 @@ void Adsr::SetTime(int seg, float time)
 
 void Adsr::SetAttackTime(float timeInS, float shape)
 {
+    DSY_PROFILE_SCOPE("Adsr::SetAttackTime");
     if((timeInS != attackTime_) || (shape != attackShape_))
     {
         attackTime_  = timeInS;
@@ -78,6 +80,7 @@ void Adsr::SetReleaseTime(float timeInS)
 
 void Adsr::SetTimeConstant(float timeInS, float& time, float& coeff)
 {
+    DSY_PROFILE_SCOPE("Adsr::SetTimeConstant");
     if(timeInS != time)
     {
         time = timeInS;
@@ -94,6 +97,7 @@ void Adsr::SetTimeConstant(float timeInS, float& time, float& coeff)
 
 float Adsr::Process(bool gate)
 {
+    DSY_PROFILE_SCOPE("Adsr::Process");
     float out = 0.0f;
 
     if(gate && !gate_) // rising edge
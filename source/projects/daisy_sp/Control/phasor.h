@@ -3,6 +3,9 @@
 #define DSY_PHASOR_H
 #ifdef __cplusplus
 
+#include "Utility/dsp.h"
+#include "Utility/phaseaccumulator.h"
+
 namespace daisysp
 {
 /** Generates a normalized signal moving from 0-1 at the specified frequency.
@@ -26,7 +29,8 @@ class Phasor
     inline void Init(float sample_rate, float freq, float initial_phase)
     {
         sample_rate_ = sample_rate;
-        phs_         = initial_phase;
+        phs_.Init();
+        phs_.Reset(initial_phase / TWOPI_F);
         SetFreq(freq);
     }
 
@@ -55,8 +59,9 @@ class Phasor
     inline float GetFreq() { return freq_; }
 
   private:
-    float freq_;
-    float sample_rate_, inc_, phs_;
+    float            freq_;
+    float            sample_rate_;
+    PhaseAccumulator phs_;
 };
 } // namespace daisysp
 #endif
@@ -7,6 +7,7 @@ using namespace daisysp;
 void AnalogBassDrum::Init(float sample_rate)
 {
     sample_rate_ = sample_rate;
+    silence_.Init(sample_rate);
 
     trig_ = false;
 
@@ -56,15 +57,16 @@ float AnalogBassDrum::Process(bool trigger)
     const float kRetrigPulseDuration = 0.05f * sample_rate_;
 
     const float scale = 0.001f / f0_;
-    const float q     = 1500.0f * powf(2.f, kOneTwelfth * decay_ * 80.0f);
+    const float q     = 1500.0f * SemitonesToRatio(decay_ * 80.0f);
     const float tone_f
-        = fmin(4.0f * f0_ * powf(2.f, kOneTwelfth * tone_ * 108.0f), 1.0f);
+        = fmin(4.0f * f0_ * SemitonesToRatio(tone_ * 108.0f), 1.0f);
     const float exciter_leak = 0.08f * (tone_ + 0.25f);
 
 
     if(trigger || trig_)
     {
         trig_ = false;
+        silence_.Reset();
 
         pulse_remaining_samples_    = kTriggerPulseDuration;
         fm_pulse_remaining_samples_ = kFMPulseDuration;
@@ -146,12 +148,14 @@ float AnalogBassDrum::Process(bool trigger)
 
     fonepole(tone_lp_, pulse * exciter_leak + resonator_out, tone_f);
 
+    silence_.Process(tone_lp_);
     return tone_lp_;
 }
 
 void AnalogBassDrum::Trig()
 {
     trig_ = true;
+    silence_.Reset();
 }
 
 void AnalogBassDrum::SetSustain(bool sustain)
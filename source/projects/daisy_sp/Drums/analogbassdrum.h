@@ -7,6 +7,7 @@
 
 #include "Synthesis/oscillator.h"
 #include "Filters/svf.h"
+#include "Utility/silencedetector.h"
 
 /** @file analogbassdrum.h */
 
@@ -39,6 +40,11 @@ class AnalogBassDrum
     /** Strikes the drum. */
     void Trig();
 
+    /** True once the output has stayed below -80 dBFS for 50 ms without
+        sustain. Process may then be skipped until the next trigger.
+    */
+    inline bool IsSilent() const { return !sustain_ && silence_.IsSilent(); }
+
     /** Set the bassdrum to play infinitely
         \param sustain True = infinite length
     */
@@ -97,6 +103,8 @@ class AnalogBassDrum
 
     Svf resonator_;
 
+    SilenceDetector silence_;
+
     //for use in sin + cos osc. in sustain mode
     float phase_;
 };
@@ -10,6 +10,7 @@ static const int kNumModes = 5;
 void AnalogSnareDrum::Init(float sample_rate)
 {
     sample_rate_ = sample_rate;
+    silence_.Init(sample_rate);
 
     trig_ = false;
 
@@ -39,6 +40,7 @@ void AnalogSnareDrum::Init(float sample_rate)
 void AnalogSnareDrum::Trig()
 {
     trig_ = true;
+    silence_.Reset();
 }
 
 void AnalogSnareDrum::SetSustain(bool sustain)
@@ -80,12 +82,11 @@ float AnalogSnareDrum::Process(bool trigger)
     const float decay_xt = decay_ * (1.0f + decay_ * (decay_ - 1.0f));
     const int   kTriggerPulseDuration = 1.0e-3 * sample_rate_;
     const float kPulseDecayTime       = 0.1e-3 * sample_rate_;
-    const float q = 2000.0f * powf(2.f, kOneTwelfth * decay_xt * 84.0f);
+    const float q = 2000.0f * SemitonesToRatio(decay_xt * 84.0f);
     const float noise_envelope_decay
         = 1.0f
           - 0.0017f
-                * powf(2.f,
-                       kOneTwelfth * (-decay_ * (50.0f + snappy_ * 10.0f)));
+                * SemitonesToRatio(-decay_ * (50.0f + snappy_ * 10.0f));
     const float exciter_leak = snappy_ * (2.0f - snappy_) * 0.1f;
 
     float snappy = snappy_ * 1.1f - 0.05f;
@@ -96,6 +97,7 @@ float AnalogSnareDrum::Process(bool trigger)
     if(trigger || trig_)
     {
         trig_                    = false;
+        silence_.Reset();
         pulse_remaining_samples_ = kTriggerPulseDuration;
         pulse_height_            = 3.0f + 7.0f * accent_;
         noise_envelope_          = 2.0f;
@@ -194,7 +196,9 @@ float AnalogSnareDrum::Process(bool trigger)
     noise = noise_filter_.Band();
 
     // IC13
-    return noise + shell * (1.0f - snappy);
+    const float out = noise + shell * (1.0f - snappy);
+    silence_.Process(out);
+    return out;
 }
 
 inline float AnalogSnareDrum::SoftLimit(float x)
@@ -3,6 +3,7 @@
 #define DSY_ANALOG_SNARE_H
 
 #include "Filters/svf.h"
+#include "Utility/silencedetector.h"
 
 #include <stdint.h>
 #ifdef __cplusplus
@@ -40,6 +41,11 @@ class AnalogSnareDrum
     /** Trigger the drum */
     void Trig();
 
+    /** True once the output has stayed below -80 dBFS for 50 ms without
+        sustain. Process may then be skipped until the next trigger.
+    */
+    inline bool IsSilent() const { return !sustain_ && silence_.IsSilent(); }
+
     /** Init the module
         \param sample_rate Audio engine sample rate
     */
@@ -90,6 +96,8 @@ class AnalogSnareDrum
     Svf resonator_[kNumModes];
     Svf noise_filter_;
 
+    SilenceDetector silence_;
+
     // Replace the resonators in "free running" (sustain) mode.
     float phase_[kNumModes];
 };
@@ -0,0 +1,275 @@
+#pragma once
+#ifndef DSY_DRUMKIT_H
+#define DSY_DRUMKIT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Drums/hihat.h"
+#include "Utility/dsp.h"
+#include "Utility/silencedetector.h"
+#ifdef __cplusplus
+
+/** @file drumkit.h */
+
+namespace daisysp
+{
+/**
+       @brief Sample-accurate multi-voice drum engine
+       @date Oct 2026
+       Drives up to max_voices drum modules (AnalogBassDrum, HiHat, ... or
+       anything with Process(bool trigger) and SetAccent(float)) owned by
+       the caller, and mixes them to one output. \n
+       Triggers carry a sample offset into the next Process call, and each
+       block is split at those offsets so a hit lands on its exact sample
+       regardless of the host's block size. \n
+       A voice goes to sleep once its output has stayed below the sleep
+       threshold for 50 ms, and is not rendered again until its next
+       trigger, so an idle kit costs almost nothing. Each voice is tracked
+       by its own SilenceDetector, so any module works without an
+       IsSilent() of its own. HiHat voices render through
+       HiHat::ProcessBlock.
+
+       declaration example:
+
+       AnalogBassDrum   kick;
+       HiHat<>          hat;
+       DrumKit<16>      kit;
+       kick.Init(sr);
+       hat.Init(sr);
+       kit.Init(sr);
+       kit.AddVoice(&kick); // voice 0
+       kit.AddVoice(&hat);  // voice 1
+       kit.Trigger(1, 0.8f, 17); // hat on sample 17 of the next block
+       kit.Process(out, size);
+*/
+template <size_t max_voices, size_t max_events = 64>
+class DrumKit
+{
+  public:
+    DrumKit() {}
+    ~DrumKit() {}
+
+    /** Initializes the engine with no voices
+        \param sample_rate Audio engine sample rate
+    */
+    void Init(float sample_rate)
+    {
+        sample_rate_     = sample_rate;
+        num_voices_      = 0;
+        num_events_      = 0;
+        sleep_threshold_ = 1.0e-4f; // -80 dBFS
+    }
+
+    /** Adds a drum module as the next voice, which starts asleep.
+        The module is not copied and must outlive the kit.
+        \param drum initialized drum module
+        \return false if the kit is full
+    */
+    template <typename T>
+    bool AddVoice(T *drum)
+    {
+        if(num_voices_ >= max_voices)
+        {
+            return false;
+        }
+        Voice &v    = voices_[num_voices_++];
+        v.drum      = drum;
+        v.render    = &Render<T>;
+        v.accent    = &Accent<T>;
+        v.level     = 1.0f;
+        v.awake     = false;
+        v.triggered = false;
+        v.silence.Init(sample_rate_, kHoldTime, sleep_threshold_);
+        return true;
+    }
+
+    /** Number of voices added */
+    inline size_t GetNumVoices() const { return num_voices_; }
+
+    /** Sets the mix level of a voice */
+    inline void SetLevel(size_t voice, float level)
+    {
+        voices_[voice].level = level;
+    }
+
+    /** Output level below which a voice may sleep, 1e-4 by default */
+    void SetSleepThreshold(float threshold)
+    {
+        sleep_threshold_ = threshold;
+        for(size_t i = 0; i < num_voices_; i++)
+        {
+            voices_[i].silence.SetThreshold(threshold);
+        }
+    }
+
+    /** Queues a hit.
+        \param voice index in AddVoice order
+        \param accent 0-1, applied with SetAccent just before the hit
+        \param offset sample position counted from the start of the next
+               Process call, may lie beyond that block
+        \return false if the event queue is full
+    */
+    bool Trigger(size_t voice, float accent = 1.0f, size_t offset = 0)
+    {
+        if(num_events_ >= max_events || voice >= num_voices_)
+        {
+            return false;
+        }
+        // keep the queue sorted by offset, equal offsets in arrival order
+        size_t i = num_events_++;
+        while(i > 0 && events_[i - 1].offset > offset)
+        {
+            events_[i] = events_[i - 1];
+            i--;
+        }
+        events_[i].offset = offset;
+        events_[i].voice  = voice;
+        events_[i].accent = accent;
+        return true;
+    }
+
+    /** Renders and mixes all awake voices
+        \param out size samples, overwritten with the mix
+        \param size number of samples
+    */
+    void Process(float *out, size_t size)
+    {
+        for(size_t i = 0; i < size; i++)
+        {
+            out[i] = 0.0f;
+        }
+
+        size_t pos = 0, e = 0;
+        while(pos < size)
+        {
+            while(e < num_events_ && events_[e].offset <= pos)
+            {
+                Hit(events_[e++]);
+            }
+            size_t end = e < num_events_ && events_[e].offset < size
+                             ? events_[e].offset
+                             : size;
+            RenderSegment(out + pos, end - pos);
+            pos = end;
+        }
+
+        // carry the events beyond this block over to the next one
+        size_t n = 0;
+        for(; e < num_events_; e++, n++)
+        {
+            events_[n] = events_[e];
+            events_[n].offset -= size;
+        }
+        num_events_ = n;
+    }
+
+    /** True if the voice is not being rendered */
+    inline bool IsSleeping(size_t voice) const
+    {
+        return !voices_[voice].awake;
+    }
+
+    /** Number of voices currently rendered */
+    size_t GetNumAwake() const
+    {
+        size_t n = 0;
+        for(size_t i = 0; i < num_voices_; i++)
+        {
+            n += voices_[i].awake ? 1 : 0;
+        }
+        return n;
+    }
+
+  private:
+    static constexpr size_t kChunkSize = 32;
+    static constexpr float  kHoldTime  = 0.05f;
+
+    struct Voice
+    {
+        void *drum;
+        void (*render)(void *drum, float *out, size_t size, bool trigger);
+        void (*accent)(void *drum, float accent);
+        float           level;
+        bool            awake;
+        bool            triggered;
+        SilenceDetector silence;
+    };
+
+    struct Event
+    {
+        size_t offset;
+        size_t voice;
+        float  accent;
+    };
+
+    template <typename T>
+    static void Render(void *drum, float *out, size_t size, bool trigger)
+    {
+        RenderDrum(*static_cast<T *>(drum), out, size, trigger);
+    }
+
+    template <typename T>
+    static void Accent(void *drum, float accent)
+    {
+        static_cast<T *>(drum)->SetAccent(accent);
+    }
+
+    template <typename T>
+    static void RenderDrum(T &drum, float *out, size_t size, bool trigger)
+    {
+        for(size_t i = 0; i < size; i++)
+        {
+            out[i] = drum.Process(trigger && i == 0);
+        }
+    }
+
+    template <typename Noise, typename VCA, bool resonance>
+    static void RenderDrum(HiHat<Noise, VCA, resonance> &drum,
+                           float                        *out,
+                           size_t                        size,
+                           bool                          trigger)
+    {
+        drum.ProcessBlock(out, size, trigger);
+    }
+
+    void Hit(const Event &event)
+    {
+        Voice &v = voices_[event.voice];
+        v.accent(v.drum, event.accent);
+        v.awake     = true;
+        v.triggered = true;
+        v.silence.Reset();
+    }
+
+    void RenderSegment(float *out, size_t size)
+    {
+        float buf[kChunkSize];
+        for(size_t i = 0; i < num_voices_; i++)
+        {
+            Voice &v = voices_[i];
+            for(size_t pos = 0; v.awake && pos < size; pos += kChunkSize)
+            {
+                const size_t n
+                    = size - pos < kChunkSize ? size - pos : kChunkSize;
+                v.render(v.drum, buf, n, v.triggered);
+                v.triggered = false;
+
+                for(size_t j = 0; j < n; j++)
+                {
+                    out[pos + j] += v.level * buf[j];
+                }
+                v.silence.ProcessBlock(buf, n);
+                v.awake = !v.silence.IsSilent();
+            }
+        }
+    }
+
+    Voice  voices_[max_voices];
+    Event  events_[max_events];
+    size_t num_voices_, num_events_;
+    float  sample_rate_, sleep_threshold_;
+};
+
+} // namespace daisysp
+#endif
+#endif
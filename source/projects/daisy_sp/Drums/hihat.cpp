@@ -6,91 +6,137 @@ using namespace daisysp;
 
 void SquareNoise::Init(float sample_rate)
 {
-    for(int i = 0; i < 6; i++)
+    for(int i = 0; i < kNumLanes; i++)
     {
         phase_[i] = 0;
     }
 }
 
-float SquareNoise::Process(float f0)
+void SquareNoise::Increments(float f0, uint32_t *increment)
 {
-    const float ratios[6] = {// Nominal f0: 414 Hz
-                             1.0f,
-                             1.304f,
-                             1.466f,
-                             1.787f,
-                             1.932f,
-                             2.536f};
-
-    uint32_t increment[6];
-    uint32_t phase[6];
-    for(int i = 0; i < 6; ++i)
+    const float ratios[kNumLanes] = {// Nominal f0: 414 Hz
+                                     1.0f,
+                                     1.304f,
+                                     1.466f,
+                                     1.787f,
+                                     1.932f,
+                                     2.536f,
+                                     // padding, these lanes never move
+                                     0.0f,
+                                     0.0f};
+
+    for(int i = 0; i < kNumLanes; ++i)
     {
         float f = f0 * ratios[i];
         if(f >= 0.499f)
             f = 0.499f;
         increment[i] = static_cast<uint32_t>(f * 4294967296.0f);
-        phase[i]     = phase_[i];
     }
+}
+
+float SquareNoise::Process(float f0)
+{
+    float out;
+    ProcessBlock(f0, &out, 1);
+    return out;
+}
 
-    phase[0] += increment[0];
-    phase[1] += increment[1];
-    phase[2] += increment[2];
-    phase[3] += increment[3];
-    phase[4] += increment[4];
-    phase[5] += increment[5];
-    uint32_t noise = 0;
-    noise += (phase[0] >> 31);
-    noise += (phase[1] >> 31);
-    noise += (phase[2] >> 31);
-    noise += (phase[3] >> 31);
-    noise += (phase[4] >> 31);
-    noise += (phase[5] >> 31);
-
-    for(int i = 0; i < 6; ++i)
+void SquareNoise::ProcessBlock(float f0, float *out, size_t size)
+{
+    uint32_t increment[kNumLanes];
+    uint32_t phase[kNumLanes];
+    Increments(f0, increment);
+    for(int i = 0; i < kNumLanes; ++i)
     {
-        phase_[i] = phase[i];
+        phase[i] = phase_[i];
     }
 
-    return 0.33f * static_cast<float>(noise) - 1.0f;
+    for(size_t n = 0; n < size; ++n)
+    {
+        // the padding lanes stay at phase 0 and add nothing
+        uint32_t noise = 0;
+        for(int i = 0; i < kNumLanes; ++i)
+        {
+            phase[i] += increment[i];
+            noise += phase[i] >> 31;
+        }
+        out[n] = 0.33f * static_cast<float>(noise) - 1.0f;
+    }
+
+    for(int i = 0; i < kNumLanes; ++i)
+    {
+        phase_[i] = phase[i];
+    }
 }
 
 void RingModNoise::Init(float sample_rate)
 {
     sample_rate_ = sample_rate;
+    sr_recip_    = 1.0f / sample_rate;
 
-    for(int i = 0; i < 6; ++i)
+    for(int i = 0; i < kNumPairs; ++i)
     {
-        oscillator_[i].Init(sample_rate_);
+        square_phase_[i] = 0.0f;
+        saw_phase_[i]    = 0.0f;
     }
 }
 
-float RingModNoise::Process(float f0)
+void RingModNoise::Increments(float f0, float *square_inc, float *saw_inc)
 {
     const float ratio = f0 / (0.01f + f0);
-    const float f1a   = 200.0f / sample_rate_ * ratio;
-    const float f1b   = 7530.0f / sample_rate_ * ratio;
-    const float f2a   = 510.0f / sample_rate_ * ratio;
-    const float f2b   = 8075.0f / sample_rate_ * ratio;
-    const float f3a   = 730.0f / sample_rate_ * ratio;
-    const float f3b   = 10500.0f / sample_rate_ * ratio;
+    const float f[2][kNumPairs]
+        = {{200.0f, 510.0f, 730.0f, 0.0f}, {7530.0f, 8075.0f, 10500.0f, 0.0f}};
 
-    float out = ProcessPair(&oscillator_[0], f1a, f1b);
-    out += ProcessPair(&oscillator_[2], f2a, f2b);
-    out += ProcessPair(&oscillator_[4], f3a, f3b);
+    for(int i = 0; i < kNumPairs; ++i)
+    {
+        // same rounding as Oscillator::SetFreq(f * sample_rate)
+        square_inc[i] = (f[0][i] / sample_rate_ * ratio) * sample_rate_;
+        square_inc[i] *= sr_recip_;
+        saw_inc[i] = (f[1][i] / sample_rate_ * ratio) * sample_rate_;
+        saw_inc[i] *= sr_recip_;
+    }
+}
 
+float RingModNoise::Process(float f0)
+{
+    float out;
+    ProcessBlock(f0, &out, 1);
     return out;
 }
 
-float RingModNoise::ProcessPair(Oscillator* osc, float f1, float f2)
+void RingModNoise::ProcessBlock(float f0, float *out, size_t size)
 {
-    osc[0].SetWaveform(Oscillator::WAVE_SQUARE);
-    osc[0].SetFreq(f1 * sample_rate_);
-    float temp_1 = osc[0].Process();
+    float square_inc[kNumPairs], saw_inc[kNumPairs];
+    float square_phase[kNumPairs], saw_phase[kNumPairs];
+    Increments(f0, square_inc, saw_inc);
+    for(int i = 0; i < kNumPairs; ++i)
+    {
+        square_phase[i] = square_phase_[i];
+        saw_phase[i]    = saw_phase_[i];
+    }
+
+    for(size_t n = 0; n < size; ++n)
+    {
+        // square and saw at Oscillator's default amplitude of 0.5
+        float ring[kNumPairs];
+        for(int i = 0; i < kNumPairs; ++i)
+        {
+            const float square = square_phase[i] < 0.5f ? 0.5f : -0.5f;
+            const float saw    = 0.5f - saw_phase[i];
+            ring[i]            = square * saw;
 
-    osc[1].SetWaveform(Oscillator::WAVE_SAW);
-    osc[1].SetFreq(f2 * sample_rate_);
-    float temp_2 = osc[1].Process();
+            square_phase[i] += square_inc[i];
+            square_phase[i] -= square_phase[i] > 1.0f ? 1.0f : 0.0f;
+            saw_phase[i] += saw_inc[i];
+            saw_phase[i] -= saw_phase[i] > 1.0f ? 1.0f : 0.0f;
+        }
+        // the fourth pair is padding
+        out[n] = ring[0] + ring[1] + ring[2];
+    }
 
-    return temp_1 * temp_2;
-}
\ No newline at end of file
+    for(int i = 0; i < kNumPairs; ++i)
+    {
+        square_phase_[i] = square_phase[i];
+        saw_phase_[i]    = saw_phase[i];
+    }
+}
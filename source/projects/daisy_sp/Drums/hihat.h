@@ -4,8 +4,10 @@
 
 #include "Filters/svf.h"
 #include "Synthesis/oscillator.h"
+#include "Utility/silencedetector.h"
 
 #include <stdint.h>
+#include <stddef.h>
 #include <stdlib.h>
 #ifdef __cplusplus
 
@@ -31,8 +33,21 @@ class SquareNoise
 
     float Process(float f0);
 
+    /** Renders a block at a fixed frequency.
+        The six oscillators sit in eight lanes (two unused) so that each
+        sample is one vector add, shift and sum.
+        \param f0 normalized frequency
+        \param out size samples
+        \param size number of samples
+    */
+    void ProcessBlock(float f0, float *out, size_t size);
+
   private:
-    uint32_t phase_[6];
+    static constexpr int kNumLanes = 8;
+
+    void Increments(float f0, uint32_t *increment);
+
+    uint32_t phase_[kNumLanes];
 };
 
 /**  
@@ -53,11 +68,24 @@ class RingModNoise
 
     float Process(float f0);
 
+    /** Renders a block at a fixed frequency.
+        The three square and three saw oscillators of the original six
+        Oscillator objects are kept as two lanes of four phases each.
+        \param f0 normalized frequency
+        \param out size samples
+        \param size number of samples
+    */
+    void ProcessBlock(float f0, float *out, size_t size);
+
   private:
-    float      ProcessPair(Oscillator* osc, float f1, float f2);
-    Oscillator oscillator_[6];
+    static constexpr int kNumPairs = 4;
 
-    float sample_rate_;
+    void Increments(float f0, float *square_inc, float *saw_inc);
+
+    float square_phase_[kNumPairs];
+    float saw_phase_[kNumPairs];
+
+    float sample_rate_, sr_recip_;
 };
 
 /**  
@@ -136,6 +164,7 @@ class HiHat
         metallic_noise_.Init(sample_rate_);
         noise_coloration_svf_.Init(sample_rate_);
         hpf_.Init(sample_rate_);
+        silence_.Init(sample_rate_);
     }
 
     /** Get the next sample
@@ -154,6 +183,7 @@ class HiHat
 
             envelope_
                 = (1.5f + 0.5f * (1.0f - decay_)) * (0.3f + 0.7f * accent_);
+            silence_.Reset();
         }
 
         // Process the metallic noise.
@@ -196,11 +226,78 @@ class HiHat
         hpf_.Process(out);
         out = hpf_.High();
 
+        silence_.Process(out);
         return out;
     }
 
+    /** Renders a block of samples.
+        Parameters are read once per block, so the filter coefficients are
+        computed once rather than every sample.
+        \param out size samples
+        \param size number of samples
+        \param trigger Hit the hihat on the first sample. Defaults to false.
+    */
+    void ProcessBlock(float *out, size_t size, bool trigger = false)
+    {
+        const float envelope_decay
+            = 1.0f - 0.003f * SemitonesToRatio(-decay_ * 84.0f);
+        const float cut_decay
+            = 1.0f - 0.0025f * SemitonesToRatio(-decay_ * 36.0f);
+
+        if(trigger || trig_)
+        {
+            trig_ = false;
+
+            envelope_
+                = (1.5f + 0.5f * (1.0f - decay_)) * (0.3f + 0.7f * accent_);
+            silence_.Reset();
+        }
+
+        metallic_noise_.ProcessBlock(2.0f * f0_, out, size);
+
+        float cutoff = 150.0f / sample_rate_ * SemitonesToRatio(tone_ * 72.0f);
+        cutoff       = fclamp(cutoff, 0.0f, 16000.0f / sample_rate_);
+
+        noise_coloration_svf_.SetFreq(cutoff * sample_rate_);
+        noise_coloration_svf_.SetRes(resonance ? 3.0f + 6.0f * tone_ : 1.0f);
+        noise_coloration_svf_.ProcessBlock<Svf::Output::BAND>(out, out, size);
+
+        float noise_f = f0_ * (16.0f + 16.0f * (1.0f - noisiness_));
+        noise_f       = fclamp(noise_f, 0.0f, 0.5f);
+
+        sustain_gain_ = accent_ * decay_;
+        VCA vca;
+        for(size_t i = 0; i < size; i++)
+        {
+            noise_clock_ += noise_f;
+            if(noise_clock_ >= 1.0f)
+            {
+                noise_clock_ -= 1.0f;
+                noise_sample_ = rand() * kRandFrac - 0.5f;
+            }
+            float s = out[i] + noisiness_ * (noise_sample_ - out[i]);
+
+            envelope_ *= envelope_ > 0.5f ? envelope_decay : cut_decay;
+            out[i] = vca(s, sustain_ ? sustain_gain_ : envelope_);
+        }
+
+        hpf_.SetFreq(cutoff * sample_rate_);
+        hpf_.SetRes(.5f);
+        hpf_.ProcessBlock<Svf::Output::HIGH>(out, out, size);
+        silence_.ProcessBlock(out, size);
+    }
+
     /** Trigger the hihat */
-    void Trig() { trig_ = true; }
+    void Trig()
+    {
+        trig_ = true;
+        silence_.Reset();
+    }
+
+    /** True once the output has stayed below -80 dBFS for 50 ms without
+        sustain. Process may then be skipped until the next trigger.
+    */
+    bool IsSilent() const { return !sustain_ && silence_.IsSilent(); }
 
     /** Make the hihat ring out infinitely.
         \param sustain True = infinite sustain.
@@ -253,8 +350,6 @@ class HiHat
     bool  sustain_;
     bool  trig_;
 
-    float SemitonesToRatio(float in) { return powf(2.f, in * kOneTwelfth); }
-
     float envelope_;
     float noise_clock_;
     float noise_sample_;
@@ -263,6 +358,7 @@ class HiHat
     MetallicNoiseSource metallic_noise_;
     Svf                 noise_coloration_svf_;
     Svf                 hpf_;
+    SilenceDetector     silence_;
 };
 } // namespace daisysp
 #endif
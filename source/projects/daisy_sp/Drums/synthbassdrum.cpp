@@ -41,6 +41,7 @@ float SyntheticBassDrumAttackNoise::Process()
 void SyntheticBassDrum::Init(float sample_rate)
 {
     sample_rate_ = sample_rate;
+    silence_.Init(sample_rate);
 
     trig_ = false;
 
@@ -104,15 +105,16 @@ float SyntheticBassDrum::Process(bool trigger)
     const float body_env_decay
         = 1.0f
           - 1.0f / (0.02f * sample_rate_)
-                * powf(2.f, (-decay_ * 60.0f) * kOneTwelfth);
+                * SemitonesToRatio(-decay_ * 60.0f);
     const float transient_env_decay = 1.0f - 1.0f / (0.005f * sample_rate_);
     const float tone_f              = fmin(
-        4.0f * new_f0_ * powf(2.f, (tone_ * 108.0f) * kOneTwelfth), 1.0f);
+        4.0f * new_f0_ * SemitonesToRatio(tone_ * 108.0f), 1.0f);
     const float transient_level = tone_;
 
     if(trigger || trig_)
     {
         trig_     = false;
+        silence_.Reset();
         fm_       = 1.0f;
         body_env_ = transient_env_ = 0.3f + 0.7f * accent_;
         body_env_pulse_width_      = sample_rate_ * 0.001f;
@@ -179,12 +181,14 @@ float SyntheticBassDrum::Process(bool trigger)
     }
 
     fonepole(tone_lp_, mix, tone_f);
+    silence_.Process(tone_lp_);
     return tone_lp_;
 }
 
 void SyntheticBassDrum::Trig()
 {
     trig_ = true;
+    silence_.Reset();
 }
 
 void SyntheticBassDrum::SetSustain(bool sustain)
@@ -3,6 +3,7 @@
 #define DSY_SYNTHBD_H
 
 #include "Filters/svf.h"
+#include "Utility/silencedetector.h"
 #include "Utility/dsp.h"
 
 #include <stdint.h>
@@ -104,6 +105,11 @@ class SyntheticBassDrum
     /** Trigger the drum */
     void Trig();
 
+    /** True once the output has stayed below -80 dBFS for 50 ms without
+        sustain. Process may then be skipped until the next trigger.
+    */
+    inline bool IsSilent() const { return !sustain_ && silence_.IsSilent(); }
+
     /** Allows the drum to play continuously
         \param sustain True sets the drum on infinite sustain.
     */
@@ -169,6 +175,7 @@ class SyntheticBassDrum
 
     SyntheticBassDrumClick       click_;
     SyntheticBassDrumAttackNoise noise_;
+    SilenceDetector              silence_;
 
     int body_env_pulse_width_;
     int fm_pulse_width_;
@@ -8,6 +8,7 @@ using namespace daisysp;
 void SyntheticSnareDrum::Init(float sample_rate)
 {
     sample_rate_ = sample_rate;
+    silence_.Init(sample_rate);
 
     phase_[0]        = 0.0f;
     phase_[1]        = 0.0f;
@@ -45,15 +46,13 @@ float SyntheticSnareDrum::Process(bool trigger)
     const float drum_decay
         = 1.0f
           - 1.0f / (0.015f * sample_rate_)
-                * powf(2.f,
-                       kOneTwelfth
-                           * (-decay_xt * 72.0f - fm_amount_ * 12.0f
-                              + snappy_ * 7.0f));
+                * SemitonesToRatio(-decay_xt * 72.0f - fm_amount_ * 12.0f
+                                   + snappy_ * 7.0f);
 
     const float snare_decay
         = 1.0f
           - 1.0f / (0.01f * sample_rate_)
-                * powf(2.f, kOneTwelfth * (-decay_ * 60.0f - snappy_ * 7.0f));
+                * SemitonesToRatio(-decay_ * 60.0f - snappy_ * 7.0f);
     const float fm_decay = 1.0f - 1.0f / (0.007f * sample_rate_);
 
     float snappy = snappy_ * 1.1f - 0.05f;
@@ -74,6 +73,7 @@ float SyntheticSnareDrum::Process(bool trigger)
     if(trigger || trig_)
     {
         trig_            = false;
+        silence_.Reset();
         snare_amplitude_ = drum_amplitude_ = 0.3f + 0.7f * accent_;
         fm_                                = 1.0f;
         phase_[0] = phase_[1] = 0.0f;
@@ -160,12 +160,16 @@ float SyntheticSnareDrum::Process(bool trigger)
     snare = snare_hp_.High();
     snare = (snare + 0.1f) * (snare_amplitude_ + fm_) * snare_level;
 
-    return snare + drum; // It's a snare, it's a drum, it's a snare drum.
+    // It's a snare, it's a drum, it's a snare drum.
+    const float out = snare + drum;
+    silence_.Process(out);
+    return out;
 }
 
 void SyntheticSnareDrum::Trig()
 {
     trig_ = true;
+    silence_.Reset();
 }
 
 void SyntheticSnareDrum::SetSustain(bool sustain)
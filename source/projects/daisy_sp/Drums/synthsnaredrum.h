@@ -3,6 +3,7 @@
 #define DSY_SYNTHSD_H
 
 #include "Filters/svf.h"
+#include "Utility/silencedetector.h"
 
 #include <stdint.h>
 #ifdef __cplusplus
@@ -42,6 +43,11 @@ class SyntheticSnareDrum
     /** Trigger the drum */
     void Trig();
 
+    /** True once the output has stayed below -80 dBFS for 50 ms without
+        sustain. Process may then be skipped until the next trigger.
+    */
+    inline bool IsSilent() const { return !sustain_ && silence_.IsSilent(); }
+
     /** Make the drum ring out infinitely.
         \param sustain True = infinite sustain.
     */
@@ -91,6 +97,8 @@ class SyntheticSnareDrum
     Svf drum_lp_;
     Svf snare_hp_;
     Svf snare_lp_;
+
+    SilenceDetector silence_;
 };
 } // namespace daisysp
 #endif
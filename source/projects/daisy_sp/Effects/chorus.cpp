@@ -5,11 +5,34 @@
 using namespace daisysp;
 
 //ChorusEngine stuff
+#ifndef DSY_NO_EMBEDDED_BUFFERS
 void ChorusEngine::Init(float sample_rate)
+{
+    del_.Init(del_buffer_, kDelayLength);
+    InitParams(sample_rate);
+}
+#endif
+
+bool ChorusEngine::Init(float sample_rate, Allocator &allocator)
+{
+    if(!del_.Init(allocator, (size_t)ceilf(kMaxDelaySeconds * sample_rate)))
+    {
+        return false;
+    }
+    InitParams(sample_rate);
+    return true;
+}
+
+size_t ChorusEngine::GetRequiredMemory(float sample_rate)
+{
+    return DelayLine<float, DELAYLINE_USER_MEMORY>::GetRequiredMemory(
+        (size_t)ceilf(kMaxDelaySeconds * sample_rate));
+}
+
+void ChorusEngine::InitParams(float sample_rate)
 {
     sample_rate_ = sample_rate;
 
-    del_.Init();
     lfo_amp_  = 0.f;
     feedback_ = .2f;
     SetDelay(.75);
@@ -82,10 +105,33 @@ float ChorusEngine::ProcessLfo()
 }
 
 //Chorus Stuff
+#ifndef DSY_NO_EMBEDDED_BUFFERS
 void Chorus::Init(float sample_rate)
 {
     engines_[0].Init(sample_rate);
     engines_[1].Init(sample_rate);
+    InitParams();
+}
+#endif
+
+bool Chorus::Init(float sample_rate, Allocator &allocator)
+{
+    if(!engines_[0].Init(sample_rate, allocator)
+       || !engines_[1].Init(sample_rate, allocator))
+    {
+        return false;
+    }
+    InitParams();
+    return true;
+}
+
+size_t Chorus::GetRequiredMemory(float sample_rate)
+{
+    return 2 * ChorusEngine::GetRequiredMemory(sample_rate);
+}
+
+void Chorus::InitParams()
+{
     SetPan(.25f, .75f);
 
     gain_frac_ = .5f;
@@ -20,10 +20,22 @@ class ChorusEngine
     ChorusEngine() {}
     ~ChorusEngine() {}
 
-    /** Initialize the module
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    /** Initialize the module, using the built-in 50 ms (at 48kHz) delay
         \param sample_rate Audio engine sample rate.
     */
     void Init(float sample_rate);
+#endif
+
+    /** Initialize the module, taking 50 ms of delay from allocator
+        \param sample_rate Audio engine sample rate.
+        \param allocator Source of the delay memory
+        \return false if the allocator is exhausted
+    */
+    bool Init(float sample_rate, Allocator &allocator);
+
+    /** Bytes Init takes from an Allocator at sample_rate */
+    static size_t GetRequiredMemory(float sample_rate);
 
     /** Get the next sample
         \param in Sample to process
@@ -57,6 +69,7 @@ class ChorusEngine
 
   private:
     float                    sample_rate_;
+    static constexpr float   kMaxDelaySeconds = .05f;
     static constexpr int32_t kDelayLength
         = 2400; // 50 ms at 48kHz = .05 * 48000
 
@@ -69,8 +82,12 @@ class ChorusEngine
 
     float delay_;
 
-    DelayLine<float, kDelayLength> del_;
+    DelayLine<float, DELAYLINE_USER_MEMORY> del_;
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    float del_buffer_[kDelayLength];
+#endif
 
+    void  InitParams(float sample_rate);
     float ProcessLfo();
 };
 
@@ -88,10 +105,22 @@ class Chorus
     Chorus() {}
     ~Chorus() {}
 
+#ifndef DSY_NO_EMBEDDED_BUFFERS
     /** Initialize the module
         \param sample_rate Audio engine sample rate
     */
     void Init(float sample_rate);
+#endif
+
+    /** Initialize the module, taking both engines' delays from allocator
+        \param sample_rate Audio engine sample rate
+        \param allocator Source of the delay memory
+        \return false if the allocator is exhausted
+    */
+    bool Init(float sample_rate, Allocator &allocator);
+
+    /** Bytes Init takes from an Allocator at sample_rate */
+    static size_t GetRequiredMemory(float sample_rate);
 
     /** Get the net floating point sample. Defaults to left channel.
         \param in Sample to process
@@ -176,6 +205,8 @@ class Chorus
     float        pan_[2];
 
     float sigl_, sigr_;
+
+    void InitParams();
 };
 } //namespace daisysp
 #endif
@@ -0,0 +1,359 @@
+#pragma once
+#ifndef DSY_FDNREVERB_H
+#define DSY_FDNREVERB_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include "Utility/dsp.h"
+#include "Utility/allocator.h"
+#include "Utility/denormal.h"
+#ifdef __cplusplus
+
+/** @file fdnreverb.h */
+
+namespace daisysp
+{
+/**
+       @brief Stereo feedback delay network reverb
+       @date Oct 2026
+       num_lines delay lines (8, 16 or 32) of mutually prime lengths between
+       19 and 83 ms, each followed by a one-pole damping filter, are fed
+       back through an orthogonal mixing matrix. More lines give a denser
+       and smoother tail at proportionally more CPU. \n
+       The mixing matrix is a Householder reflection (N adds, N multiplies)
+       or a fast Hadamard transform (N log2 N adds). Both run on plain
+       arrays across lines, so the compiler vectorizes them. \n
+       Only the first num_lines / 4 lines are modulated, with linear
+       interpolation; the others are read directly. \n
+       Delay memory comes from an Allocator, see GetRequiredMemory. \n
+       Left input feeds the even lines and left output taps them, right the
+       odd lines.
+*/
+template <size_t num_lines>
+class FdnReverb
+{
+    static_assert(num_lines == 8 || num_lines == 16 || num_lines == 32,
+                  "FdnReverb supports 8, 16 or 32 lines");
+
+  public:
+    FdnReverb() {}
+    ~FdnReverb() {}
+
+    /** Feedback matrix */
+    enum class Mixing
+    {
+        HOUSEHOLDER,
+        HADAMARD,
+    };
+
+    /** Initializes the reverb with delay memory from allocator.
+        \param sample_rate Audio engine sample rate
+        \param allocator source of GetRequiredMemory(sample_rate) bytes
+        \return false if the allocator is exhausted
+
+        Defaults:
+        - feedback = 0.9
+        - lp_freq = 10 kHz
+        - mixing = Hadamard
+        - mod depth = 0.5, mod rate = 0.7 Hz
+    */
+    bool Init(float sample_rate, Allocator &allocator)
+    {
+        sample_rate_ = sample_rate;
+        ComputeLengths(sample_rate, len_);
+        const size_t mod_room = ModRoom(sample_rate);
+        for(size_t i = 0; i < num_lines; i++)
+        {
+            size_[i] = len_[i] + (i < kNumModulated ? mod_room : 0);
+            buf_[i]  = allocator.AllocateArray<float>(size_[i]);
+            if(buf_[i] == nullptr)
+            {
+                return false;
+            }
+            pos_[i] = 0;
+            lp_[i]  = 0.0f;
+        }
+        for(size_t i = 0; i < kNumModulated; i++)
+        {
+            mod_phase_[i] = (float)i / kNumModulated;
+        }
+        mixing_    = Mixing::HADAMARD;
+        feedback_  = 0.9f;
+        mod_depth_ = 0.0f;
+        SetLpFreq(10000.0f);
+        SetModDepth(0.5f);
+        SetModRate(0.7f);
+        UpdateGains();
+        return true;
+    }
+
+    /** Bytes Init takes from an Allocator at sample_rate */
+    static size_t GetRequiredMemory(float sample_rate)
+    {
+        size_t len[num_lines];
+        ComputeLengths(sample_rate, len);
+        const size_t mod_room = ModRoom(sample_rate);
+        size_t       bytes    = 0;
+        for(size_t i = 0; i < num_lines; i++)
+        {
+            const size_t size = len[i] + (i < kNumModulated ? mod_room : 0);
+            bytes += AlignedSize(size * sizeof(float));
+        }
+        return bytes;
+    }
+
+    /** Processes one stereo sample
+        \param in1 left input
+        \param in2 right input
+        \param out1 left output
+        \param out2 right output
+    */
+    void Process(const float &in1, const float &in2, float *out1, float *out2)
+    {
+        // outputs are written before the inputs are mixed in, so copy them
+        // in case they alias
+        const float left = in1, right = in2;
+
+        float x[num_lines];
+        Read(x);
+
+        float l = 0.0f, r = 0.0f;
+        for(size_t i = 0; i < num_lines; i++)
+        {
+            lp_[i] = FlushDenormal(lp_[i] + damp_ * (x[i] - lp_[i]));
+            x[i]   = lp_[i] * gain_[i];
+        }
+        for(size_t i = 0; i < num_lines; i += 4)
+        {
+            l += x[i] - x[i + 2];
+            r += x[i + 1] - x[i + 3];
+        }
+        *out1 = l * out_gain_;
+        *out2 = r * out_gain_;
+
+        if(mixing_ == Mixing::HADAMARD)
+        {
+            Hadamard(x);
+        }
+        else
+        {
+            Householder(x);
+        }
+
+        for(size_t i = 0; i < num_lines; i += 2)
+        {
+            x[i] += left;
+            x[i + 1] += right;
+        }
+        Write(x);
+    }
+
+    /** Processes a block of stereo samples, buffers may alias
+        \param in1 left input
+        \param in2 right input
+        \param out1 left output
+        \param out2 right output
+        \param size number of samples
+    */
+    void ProcessBlock(const float *in1,
+                      const float *in2,
+                      float       *out1,
+                      float       *out2,
+                      size_t       size)
+    {
+        for(size_t i = 0; i < size; i++)
+        {
+            Process(in1[i], in2[i], &out1[i], &out2[i]);
+        }
+    }
+
+    /** Controls the reverb time, infinite when set to 1.0
+        \param fb gain over the mean line length, range 0.0 to 1.0
+    */
+    void SetFeedback(float fb)
+    {
+        feedback_ = fclamp(fb, 0.0f, 1.0f);
+        UpdateGains();
+    }
+
+    /** Cutoff of the damping filter in each line
+        \param freq in Hz, range 0.0 to sample_rate / 2
+    */
+    void SetLpFreq(float freq)
+    {
+        freq  = fclamp(freq, 0.0f, sample_rate_ * 0.5f);
+        damp_ = 1.0f - expf(-TWOPI_F * freq / sample_rate_);
+    }
+
+    /** Selects the feedback matrix */
+    void SetMixing(Mixing mixing)
+    {
+        mixing_ = mixing;
+        UpdateGains();
+    }
+
+    /** Sets the modulation excursion
+        \param depth range 0.0 (off) to 1.0 (1 ms)
+    */
+    inline void SetModDepth(float depth)
+    {
+        mod_depth_ = fclamp(depth, 0.0f, 1.0f) * kMaxModDepth * sample_rate_;
+    }
+
+    /** Sets the modulation rate in Hz */
+    inline void SetModRate(float freq) { mod_inc_ = freq / sample_rate_; }
+
+  private:
+    static constexpr size_t kNumModulated = num_lines / 4;
+    static constexpr float  kMinDelay     = 0.019f;
+    static constexpr float  kMaxDelay     = 0.083f;
+    static constexpr float  kMaxModDepth  = 0.001f;
+
+    static bool IsPrime(size_t n)
+    {
+        if(n < 2)
+        {
+            return false;
+        }
+        for(size_t d = 2; d * d <= n; d++)
+        {
+            if(n % d == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // geometric spread of times, each rounded up to the next unused prime
+    static void ComputeLengths(float sample_rate, size_t *len)
+    {
+        size_t prev = 1;
+        for(size_t i = 0; i < num_lines; i++)
+        {
+            const float t = kMinDelay
+                            * powf(kMaxDelay / kMinDelay,
+                                   (float)i / (float)(num_lines - 1));
+            size_t n = (size_t)(t * sample_rate);
+            n        = n > prev ? n : prev + 1;
+            while(!IsPrime(n))
+            {
+                n++;
+            }
+            len[i] = prev = n;
+        }
+    }
+
+    // extra samples a modulated line needs past its nominal length
+    static size_t ModRoom(float sample_rate)
+    {
+        return (size_t)ceilf(2.0f * kMaxModDepth * sample_rate) + 2;
+    }
+
+    void UpdateGains()
+    {
+        float mean = 0.0f;
+        for(size_t i = 0; i < num_lines; i++)
+        {
+            mean += len_[i];
+        }
+        mean /= num_lines;
+        // Hadamard needs 1/sqrt(N) to stay orthogonal, applied here instead
+        // and undone on the output taps
+        const float norm
+            = mixing_ == Mixing::HADAMARD ? 1.0f / sqrtf((float)num_lines)
+                                          : 1.0f;
+        // equal decay rate on every line regardless of its length
+        for(size_t i = 0; i < num_lines; i++)
+        {
+            gain_[i] = powf(feedback_, len_[i] / mean) * norm;
+        }
+        out_gain_ = 1.0f / (sqrtf(num_lines * 0.5f) * norm);
+    }
+
+    void Read(float *x)
+    {
+        for(size_t i = 0; i < kNumModulated; i++)
+        {
+            mod_phase_[i] += mod_inc_;
+            mod_phase_[i] -= mod_phase_[i] >= 1.0f ? 1.0f : 0.0f;
+            const float d
+                = len_[i] + mod_depth_ * (1.0f + fastsin2pi(mod_phase_[i]));
+            const int32_t d_int = (int32_t)d;
+            const float   frac  = d - d_int;
+            int32_t       a     = (int32_t)pos_[i] - d_int;
+            a += a < 0 ? (int32_t)size_[i] : 0;
+            const int32_t b = a > 0 ? a - 1 : (int32_t)size_[i] - 1;
+            x[i]            = buf_[i][a] + frac * (buf_[i][b] - buf_[i][a]);
+        }
+        // unmodulated lines are exactly len long, the oldest sample is at pos
+        for(size_t i = kNumModulated; i < num_lines; i++)
+        {
+            x[i] = buf_[i][pos_[i]];
+        }
+    }
+
+    void Write(const float *x)
+    {
+        for(size_t i = 0; i < num_lines; i++)
+        {
+            buf_[i][pos_[i]] = x[i];
+            pos_[i]          = pos_[i] + 1 < size_[i] ? pos_[i] + 1 : 0;
+        }
+    }
+
+    // constant geometry transform: the same pairwise stage applied log2(N)
+    // times, each a contiguous loop over N / 2 butterflies. The 1/sqrt(N)
+    // normalization is folded into gain_.
+    static void Hadamard(float *x)
+    {
+        float  tmp[num_lines];
+        float *src = x, *dst = tmp;
+        for(size_t h = 1; h < num_lines; h *= 2)
+        {
+            for(size_t k = 0; k < num_lines / 2; k++)
+            {
+                dst[k]                 = src[2 * k] + src[2 * k + 1];
+                dst[k + num_lines / 2] = src[2 * k] - src[2 * k + 1];
+            }
+            float *t = src;
+            src      = dst;
+            dst      = t;
+        }
+        if(src != x)
+        {
+            for(size_t i = 0; i < num_lines; i++)
+            {
+                x[i] = src[i];
+            }
+        }
+    }
+
+    static void Householder(float *x)
+    {
+        float sum = 0.0f;
+        for(size_t i = 0; i < num_lines; i++)
+        {
+            sum += x[i];
+        }
+        sum *= 2.0f / num_lines;
+        for(size_t i = 0; i < num_lines; i++)
+        {
+            x[i] -= sum;
+        }
+    }
+
+    float  sample_rate_;
+    float  feedback_, damp_, out_gain_;
+    float  mod_depth_, mod_inc_;
+    Mixing mixing_;
+    float *buf_[num_lines];
+    size_t size_[num_lines], len_[num_lines], pos_[num_lines];
+    float  gain_[num_lines], lp_[num_lines];
+    float  mod_phase_[kNumModulated];
+};
+
+} // namespace daisysp
+#endif
+#endif
@@ -4,13 +4,36 @@
 
 using namespace daisysp;
 
+#ifndef DSY_NO_EMBEDDED_BUFFERS
 void Flanger::Init(float sample_rate)
+{
+    del_.Init(del_buffer_, kDelayLength);
+    InitParams(sample_rate);
+}
+#endif
+
+bool Flanger::Init(float sample_rate, Allocator &allocator)
+{
+    if(!del_.Init(allocator, (size_t)ceilf(kMaxDelaySeconds * sample_rate)))
+    {
+        return false;
+    }
+    InitParams(sample_rate);
+    return true;
+}
+
+size_t Flanger::GetRequiredMemory(float sample_rate)
+{
+    return DelayLine<float, DELAYLINE_USER_MEMORY>::GetRequiredMemory(
+        (size_t)ceilf(kMaxDelaySeconds * sample_rate));
+}
+
+void Flanger::InitParams(float sample_rate)
 {
     sample_rate_ = sample_rate;
 
     SetFeedback(.2f);
 
-    del_.Init();
     lfo_amp_ = 0.f;
     SetDelay(.75);
 
@@ -18,10 +18,22 @@ namespace daisysp
 class Flanger
 {
   public:
-    /** Initialize the modules
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    /** Initialize the module, using the built-in 20 ms (at 48kHz) delay
         \param sample_rate Audio engine sample rate.
     */
     void Init(float sample_rate);
+#endif
+
+    /** Initialize the module, taking 20 ms of delay from allocator
+        \param sample_rate Audio engine sample rate.
+        \param allocator Source of the delay memory
+        \return false if the allocator is exhausted
+    */
+    bool Init(float sample_rate, Allocator &allocator);
+
+    /** Bytes Init takes from an Allocator at sample_rate */
+    static size_t GetRequiredMemory(float sample_rate);
 
     /** Get the next sample
         \param in Sample to process
@@ -55,6 +67,7 @@ class Flanger
 
   private:
     float                    sample_rate_;
+    static constexpr float   kMaxDelaySeconds = .02f;
     static constexpr int32_t kDelayLength = 960; // 20 ms at 48kHz = .02 * 48000
 
     float feedback_;
@@ -66,8 +79,12 @@ class Flanger
 
     float delay_;
 
-    DelayLine<float, kDelayLength> del_;
+    DelayLine<float, DELAYLINE_USER_MEMORY> del_;
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    float del_buffer_[kDelayLength];
+#endif
 
+    void  InitParams(float sample_rate);
     float ProcessLfo();
 };
 } //namespace daisysp
@@ -0,0 +1,358 @@
+#pragma once
+#ifndef DSY_GRANULAR_H
+#define DSY_GRANULAR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Utility/dsp.h"
+#ifdef __cplusplus
+
+/** @file granular.h */
+
+namespace daisysp
+{
+/**
+       @brief Granular processor over a recorded buffer
+       @date Oct 2026
+       Records its input into a caller buffer, as Looper does, and plays
+       up to max_grains overlapping grains out of it. Grains are spawned at
+       a set density, at sample-accurate times within each block, or on
+       Trigger(). \n
+       Grains live in a fixed pool stored as structure-of-arrays. Active
+       grains are kept packed at the front of the pool and only they are
+       processed, so CPU follows the number of sounding grains and not
+       max_grains. Each grain renders its share of a block in one loop with
+       linear interpolated buffer reads and a precomputed window table. \n
+       With recording off the buffer is frozen and grains scan its last
+       recorded contents. With recording on, position 0 is just behind the
+       write head, and grains are placed so the head does not overtake them
+       while they play. That assumes later blocks are no longer than the
+       current one.
+*/
+template <size_t max_grains = 128>
+class Granular
+{
+  public:
+    Granular() {}
+    ~Granular() {}
+
+    /** Grain envelope */
+    enum class Window
+    {
+        HANN,  /**< smooth, overlap 2 or more for a steady texture */
+        TUKEY, /**< flat top, 12.5% cosine fade each end, clearer grains */
+    };
+
+    /** Initializes the processor
+        \param sample_rate Audio engine sample rate
+        \param buff buffer to record into, kept in either main() or global space
+        \param size size of buff in samples
+
+        Defaults:
+        - recording on
+        - 20 grains/s of 100 ms, Hann window
+        - position 0.5, no pitch shift, no spray
+    */
+    void Init(float sample_rate, float *buff, size_t size)
+    {
+        sample_rate_ = sample_rate;
+        buf_         = buff;
+        size_        = size;
+        for(size_t i = 0; i < size_; i++)
+        {
+            buf_[i] = 0.0f;
+        }
+        write_pos_   = 0;
+        recorded_    = 0;
+        recording_   = true;
+        num_active_  = 0;
+        spawn_phase_ = 1.0f;
+        triggered_   = false;
+        window_      = Window::HANN;
+
+        for(size_t i = 0; i <= kWindowSize; i++)
+        {
+            const float x = (float)i / kWindowSize;
+            windows_[0][i] = 0.5f - 0.5f * cosf(TWOPI_F * x);
+            const float e  = x < 0.5f ? x : 1.0f - x;
+            windows_[1][i]
+                = e < 0.125f ? 0.5f - 0.5f * cosf(PI_F * e * 8.0f) : 1.0f;
+        }
+        windows_[0][kWindowSize + 1] = windows_[1][kWindowSize + 1] = 0.0f;
+
+        SetDensity(20.0f);
+        SetGrainSize(0.1f);
+        SetPosition(0.5f);
+        SetPitch(0.0f);
+        SetPositionSpray(0.0f);
+        SetPitchSpray(0.0f);
+        SetGain(1.0f);
+    }
+
+    /** Records one sample and returns the sum of the grains */
+    float Process(float in)
+    {
+        float out;
+        ProcessBlock(&in, &out, 1);
+        return out;
+    }
+
+    /** Records a block and renders the grains
+        \param in size input samples
+        \param out size output samples, may be the same buffer as in
+        \param size number of samples
+    */
+    void ProcessBlock(const float *in, float *out, size_t size)
+    {
+        // record first, so a grain spawned at sample n reads behind the
+        // write head as it was at n
+        const size_t block_start = write_pos_;
+        if(recording_)
+        {
+            for(size_t n = 0; n < size; n++)
+            {
+                buf_[write_pos_] = in[n];
+                write_pos_       = write_pos_ + 1 < size_ ? write_pos_ + 1 : 0;
+            }
+            recorded_ = recorded_ + size < size_ ? recorded_ + size : size_;
+        }
+        for(size_t n = 0; n < size; n++)
+        {
+            out[n] = 0.0f;
+        }
+
+        if(triggered_)
+        {
+            triggered_ = false;
+            Spawn(recording_ ? block_start : write_pos_, size);
+        }
+
+        // split the block at each scheduled grain start
+        size_t n = 0;
+        while(n < size)
+        {
+            size_t end = size;
+            bool   spawn = false;
+            if(spawn_inc_ > 0.0f)
+            {
+                const float  wait = (1.0f - spawn_phase_) / spawn_inc_;
+                const size_t at   = n + (wait > 0.0f ? (size_t)ceilf(wait) : 0);
+                if(at < size)
+                {
+                    end   = at;
+                    spawn = true;
+                }
+            }
+            Render(out + n, end - n);
+            spawn_phase_ += spawn_inc_ * (end - n);
+            n = end;
+            if(spawn)
+            {
+                spawn_phase_ -= 1.0f;
+                spawn_phase_ = spawn_phase_ < 0.0f ? 0.0f : spawn_phase_;
+                size_t head  = write_pos_;
+                if(recording_)
+                {
+                    // blocks may be longer than the buffer
+                    head = (block_start + n) % size_;
+                }
+                Spawn(head, size);
+            }
+        }
+    }
+
+    /** Starts a grain at the next block, in addition to the density */
+    inline void Trigger() { triggered_ = true; }
+
+    /** Turns recording into the buffer on or off (freeze) */
+    inline void SetRecord(bool recording) { recording_ = recording; }
+
+    /** Sets the grain rate
+        \param density grains per second, 0 for Trigger() only
+    */
+    inline void SetDensity(float density)
+    {
+        spawn_inc_ = fmax(density, 0.0f) / sample_rate_;
+    }
+
+    /** Sets the grain length in seconds, 5 ms to 1 s */
+    inline void SetGrainSize(float seconds)
+    {
+        grain_size_ = fclamp(seconds, 0.005f, 1.0f) * sample_rate_;
+    }
+
+    /** Sets where grains start
+        \param position 0.0 (newest audio) to 1.0 (oldest)
+    */
+    inline void SetPosition(float position)
+    {
+        position_ = fclamp(position, 0.0f, 1.0f);
+    }
+
+    /** Sets the playback pitch of new grains in semitones */
+    inline void SetPitch(float semitones) { pitch_ = semitones; }
+
+    /** Random offset added to the position of each grain, 0 to 1 */
+    inline void SetPositionSpray(float spray)
+    {
+        position_spray_ = fclamp(spray, 0.0f, 1.0f);
+    }
+
+    /** Random pitch offset of each grain, up to +/- semitones */
+    inline void SetPitchSpray(float semitones)
+    {
+        pitch_spray_ = fmax(semitones, 0.0f);
+    }
+
+    /** Sets the envelope of new grains */
+    inline void SetWindow(Window window) { window_ = window; }
+
+    /** Sets the output gain */
+    inline void SetGain(float gain) { gain_ = gain; }
+
+    /** Returns the number of grains currently playing */
+    inline size_t GetNumActive() const { return num_active_; }
+
+  private:
+    static constexpr size_t kWindowSize = 512;
+
+    float Random() { return rand() * kRandFrac; }
+
+    // head is the write position at the grain start, block the length of
+    // the current block
+    void Spawn(size_t head, size_t block)
+    {
+        if(num_active_ >= max_grains || recorded_ < 2)
+        {
+            return;
+        }
+        const float spray = pitch_spray_ * (2.0f * Random() - 1.0f);
+        const float rate  = SemitonesToRatio(pitch_ + spray);
+
+        // keep the whole grain inside the recorded audio. While recording,
+        // each block is recorded before its grains play, so the head runs
+        // up to a block ahead and keeps overwriting the oldest audio.
+        float room = recorded_ - 2.0f;
+        if(recording_)
+        {
+            room -= block;
+        }
+        if(room < 1.0f)
+        {
+            return;
+        }
+        // a grain needs its span of audio. Slower than real time it also
+        // needs (1 - rate) * length more, or the head catches up with it.
+        const float speed  = recording_ ? fmax(rate, 1.0f) : rate;
+        float       length = grain_size_;
+        if(length * speed > room)
+        {
+            length = room / speed;
+        }
+        const float span   = length * rate;
+        const float usable = recording_ ? room - (speed - rate) * length : room;
+        float       pos = position_ + position_spray_ * (Random() - 0.5f);
+        pos             = fclamp(pos, 0.0f, 1.0f);
+        // one sample back, so the interpolation never reads the head
+        const float delay = 1.0f + span + pos * (usable - span);
+
+        size_t back  = (size_t)delay + 1;
+        size_t start = head >= back ? head - back : head + size_ - back;
+
+        const size_t g = num_active_++;
+        start_[g]      = (int32_t)start;
+        offset_[g]     = 1.0f - (delay - (size_t)delay); // fraction past start
+        rate_[g]       = rate;
+        env_[g]        = 0.0f;
+        env_inc_[g]    = 1.0f / fmax(length, 1.0f);
+        window_of_[g]  = window_ == Window::HANN ? 0 : 1;
+        // overlapping grains add up roughly as sqrt of the overlap
+        const float overlap = fmax(spawn_inc_ * grain_size_, 1.0f);
+        amp_[g]             = gain_ / sqrtf(overlap);
+    }
+
+    // renders the active grains into out and drops the finished ones
+    void Render(float *out, size_t size)
+    {
+        const int32_t buf_size = (int32_t)size_;
+        for(size_t g = 0; g < num_active_; g++)
+        {
+            const float  *w       = windows_[window_of_[g]];
+            const int32_t start   = start_[g];
+            const float   rate    = rate_[g];
+            const float   env_inc = env_inc_[g];
+            const float   amp     = amp_[g];
+            const float   offset  = offset_[g];
+            const float   env     = env_[g];
+
+            // stop at the end of the window, the read position stays
+            // inside the span Spawn checked
+            const float  left  = (1.0f - env) / env_inc;
+            const size_t count = left < size ? (size_t)ceilf(left) : size;
+            for(size_t n = 0; n < count; n++)
+            {
+                const float   o  = offset + rate * n;
+                const int32_t i  = (int32_t)o;
+                int32_t       i0 = start + i;
+                i0               = i0 < buf_size ? i0 : i0 - buf_size;
+                const int32_t i1 = i0 + 1 < buf_size ? i0 + 1 : 0;
+                const float   s  = buf_[i0] + (buf_[i1] - buf_[i0]) * (o - i);
+
+                float e = (env + env_inc * n) * kWindowSize;
+                e       = e < kWindowSize ? e : kWindowSize;
+                const int32_t j  = (int32_t)e;
+                const float   wv = w[j] + (w[j + 1] - w[j]) * (e - j);
+                out[n] += s * wv * amp;
+            }
+            offset_[g] = offset + rate * count;
+            env_[g]    = count < size ? 1.0f : env + env_inc * size;
+        }
+
+        // swap finished grains out of the active range
+        size_t g = 0;
+        while(g < num_active_)
+        {
+            if(env_[g] >= 1.0f)
+            {
+                num_active_--;
+                start_[g]     = start_[num_active_];
+                offset_[g]    = offset_[num_active_];
+                rate_[g]      = rate_[num_active_];
+                env_[g]       = env_[num_active_];
+                env_inc_[g]   = env_inc_[num_active_];
+                amp_[g]       = amp_[num_active_];
+                window_of_[g] = window_of_[num_active_];
+            }
+            else
+            {
+                g++;
+            }
+        }
+    }
+
+    float *buf_;
+    size_t size_, write_pos_, recorded_;
+    bool   recording_, triggered_;
+
+    float  sample_rate_, spawn_phase_, spawn_inc_, grain_size_;
+    float  position_, position_spray_, pitch_, pitch_spray_, gain_;
+    Window window_;
+
+    float windows_[2][kWindowSize + 2];
+
+    // grain pool, active grains first
+    size_t  num_active_;
+    int32_t start_[max_grains];
+    float   offset_[max_grains]; // read position past start_, in samples
+    float   rate_[max_grains];
+    float   env_[max_grains]; // window phase, 0 to 1
+    float   env_inc_[max_grains];
+    float   amp_[max_grains];
+    uint8_t window_of_[max_grains];
+};
+
+} // namespace daisysp
+#endif
+#endif
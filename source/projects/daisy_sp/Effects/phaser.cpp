@@ -5,11 +5,34 @@
 using namespace daisysp;
 
 //PhaserEngine stuff
+#ifndef DSY_NO_EMBEDDED_BUFFERS
 void PhaserEngine::Init(float sample_rate)
+{
+    del_.Init(del_buffer_, kDelayLength);
+    InitParams(sample_rate);
+}
+#endif
+
+bool PhaserEngine::Init(float sample_rate, Allocator &allocator)
+{
+    if(!del_.Init(allocator, (size_t)ceilf(kMaxDelaySeconds * sample_rate)))
+    {
+        return false;
+    }
+    InitParams(sample_rate);
+    return true;
+}
+
+size_t PhaserEngine::GetRequiredMemory(float sample_rate)
+{
+    return DelayLine<float, DELAYLINE_USER_MEMORY>::GetRequiredMemory(
+        (size_t)ceilf(kMaxDelaySeconds * sample_rate));
+}
+
+void PhaserEngine::InitParams(float sample_rate)
 {
     sample_rate_ = sample_rate;
 
-    del_.Init();
     lfo_amp_  = 0.f;
     feedback_ = .2f;
     SetFreq(200.f);
@@ -77,13 +100,37 @@ float PhaserEngine::ProcessLfo()
 }
 
 //Phaser Stuff
+#ifndef DSY_NO_EMBEDDED_BUFFERS
 void Phaser::Init(float sample_rate)
 {
     for(size_t i = 0; i < kMaxPoles; i++)
     {
         engines_[i].Init(sample_rate);
     }
+    InitParams();
+}
+#endif
 
+bool Phaser::Init(float sample_rate, Allocator &allocator)
+{
+    for(size_t i = 0; i < kMaxPoles; i++)
+    {
+        if(!engines_[i].Init(sample_rate, allocator))
+        {
+            return false;
+        }
+    }
+    InitParams();
+    return true;
+}
+
+size_t Phaser::GetRequiredMemory(float sample_rate)
+{
+    return kMaxPoles * PhaserEngine::GetRequiredMemory(sample_rate);
+}
+
+void Phaser::InitParams()
+{
     poles_     = 4;
     gain_frac_ = .5f;
 }
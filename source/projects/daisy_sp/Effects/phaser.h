@@ -20,10 +20,22 @@ class PhaserEngine
     PhaserEngine() {}
     ~PhaserEngine() {}
 
-    /** Initialize the module
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    /** Initialize the module, using the built-in 50 ms (at 48kHz) delay
         \param sample_rate Audio engine sample rate.
     */
     void Init(float sample_rate);
+#endif
+
+    /** Initialize the module, taking 50 ms of delay from allocator
+        \param sample_rate Audio engine sample rate.
+        \param allocator Source of the delay memory
+        \return false if the allocator is exhausted
+    */
+    bool Init(float sample_rate, Allocator &allocator);
+
+    /** Bytes Init takes from an Allocator at sample_rate */
+    static size_t GetRequiredMemory(float sample_rate);
 
     /** Get the next sample
         \param in Sample to process
@@ -52,6 +64,7 @@ class PhaserEngine
 
   private:
     float                    sample_rate_;
+    static constexpr float   kMaxDelaySeconds = .05f;
     static constexpr int32_t kDelayLength
         = 2400; // 50 ms at 48kHz = .05 * 48000
 
@@ -68,8 +81,12 @@ class PhaserEngine
     float deltime_;
     float last_sample_;
 
-    DelayLine<float, kDelayLength> del_;
+    DelayLine<float, DELAYLINE_USER_MEMORY> del_;
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    float del_buffer_[kDelayLength];
+#endif
 
+    void  InitParams(float sample_rate);
     float ProcessLfo();
 };
 
@@ -85,10 +102,22 @@ class Phaser
     Phaser() {}
     ~Phaser() {}
 
+#ifndef DSY_NO_EMBEDDED_BUFFERS
     /** Initialize the module
         \param sample_rate Audio engine sample rate
     */
     void Init(float sample_rate);
+#endif
+
+    /** Initialize the module, taking every engine's delay from allocator
+        \param sample_rate Audio engine sample rate
+        \param allocator Source of the delay memory
+        \return false if the allocator is exhausted
+    */
+    bool Init(float sample_rate, Allocator &allocator);
+
+    /** Bytes Init takes from an Allocator at sample_rate */
+    static size_t GetRequiredMemory(float sample_rate);
 
     /** Get the next floating point sample.
         \param in Sample to process
@@ -125,6 +154,8 @@ class Phaser
     PhaserEngine         engines_[kMaxPoles];
     float                gain_frac_;
     int                  poles_;
+
+    void InitParams();
 };
 } //namespace daisysp
 #endif
@@ -58,9 +58,41 @@ class PitchShifter
   public:
     PitchShifter() {}
     ~PitchShifter() {}
-    /** Initialize pitch shifter
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    /** Initialize pitch shifter, using the built-in SHIFT_BUFFER_SIZE delays
     */
     void Init(float sr)
+    {
+        d_[0].Init(buffer_[0], SHIFT_BUFFER_SIZE);
+        d_[1].Init(buffer_[1], SHIFT_BUFFER_SIZE);
+        InitParams(sr);
+    }
+#endif
+
+    /** Initialize pitch shifter, taking both delays from allocator.
+        They are scaled from SHIFT_BUFFER_SIZE at 48kHz to keep the same
+        maximum delay time at any sample rate.
+        \return false if the allocator is exhausted
+    */
+    bool Init(float sr, Allocator &allocator)
+    {
+        const size_t size = BufferSize(sr);
+        if(!d_[0].Init(allocator, size) || !d_[1].Init(allocator, size))
+        {
+            return false;
+        }
+        InitParams(sr);
+        return true;
+    }
+
+    /** Bytes Init takes from an Allocator at sample rate sr */
+    static size_t GetRequiredMemory(float sr)
+    {
+        return 2 * ShiftDelay::GetRequiredMemory(BufferSize(sr));
+    }
+
+  private:
+    void InitParams(float sr)
     {
         force_recalc_ = false;
         sr_           = sr;
@@ -69,15 +101,21 @@ class PitchShifter
         for(uint8_t i = 0; i < 2; i++)
         {
             gain_[i] = 0.0f;
-            d_[i].Init();
             phs_[i].Init(sr, 50, i == 0 ? 0 : PI_F);
         }
         shift_up_ = true;
-        del_size_ = SHIFT_BUFFER_SIZE;
+        del_size_ = d_[0].GetSize();
         SetDelSize(del_size_);
         fun_ = 0.0f;
     }
 
+    static size_t BufferSize(float sr)
+    {
+        return (size_t)ceilf(SHIFT_BUFFER_SIZE * sr / 48000.f);
+    }
+
+  public:
+
     /** process pitch shifter
     */
     float Process(float &in)
@@ -172,7 +210,8 @@ class PitchShifter
     */
     void SetDelSize(uint32_t size)
     {
-        del_size_     = size < SHIFT_BUFFER_SIZE ? size : SHIFT_BUFFER_SIZE;
+        const uint32_t max_size = d_[0].GetSize();
+        del_size_               = size < max_size ? size : max_size;
         force_recalc_ = true;
         SetTransposition(transpose_);
     }
@@ -186,13 +225,16 @@ class PitchShifter
     {
         for(size_t i = 0; i < 12; i++)
         {
-            semitone_ratios_[i] = powf(2.0f, (float)i / 12);
+            semitone_ratios_[i] = SemitonesToRatio((float)i);
         }
     }
-    typedef DelayLine<float, SHIFT_BUFFER_SIZE> ShiftDelay;
-    ShiftDelay                                  d_[2];
-    float                                       pitch_shift_, mod_freq_;
-    uint32_t                                    del_size_;
+    typedef DelayLine<float, DELAYLINE_USER_MEMORY> ShiftDelay;
+    ShiftDelay                                      d_[2];
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    float buffer_[2][SHIFT_BUFFER_SIZE];
+#endif
+    float    pitch_shift_, mod_freq_;
+    uint32_t del_size_;
     /** lfo stuff
 */
     bool   force_recalc_;
@@ -1,8 +1,11 @@
 #include <math.h>
+#include <cmath>
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
 #include "reverbsc.h"
+#include "denormal.h"
+#include "profile.h"
 
 #define REVSC_OK 0
 #define REVSC_NOT_OK 1
@@ -37,12 +40,34 @@ static const float kReverbParams[8][4]
        {(1933.0 / DEFAULT_SRATE), 0.0006, 3.221, 14417.0}};
 
 static int DelayLineMaxSamples(float sr, float i_pitch_mod, int n);
+static size_t TotalDelaySamples(float sr);
 //static int InitDelayLine(dsy_reverbsc_dl *lp, int n);
-static int         DelayLineBytesAlloc(float sr, float i_pitch_mod, int n);
 static const float kOutputGain = 0.35;
 static const float kJpScale    = 0.25;
 
-int ReverbSc::Init(float sr)
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+template <typename T>
+int ReverbScT<T>::Init(float sr)
+{
+    return InitDelayLines(sr, aux_, DSY_REVERBSC_MAX_SIZE);
+}
+#endif
+
+template <typename T>
+int ReverbScT<T>::Init(float sr, Allocator &allocator)
+{
+    size_t size = TotalDelaySamples(sr);
+    return InitDelayLines(sr, allocator.AllocateArray<T>(size), size);
+}
+
+template <typename T>
+size_t ReverbScT<T>::GetRequiredMemory(float sample_rate)
+{
+    return AlignedSize(TotalDelaySamples(sample_rate) * sizeof(T));
+}
+
+template <typename T>
+int ReverbScT<T>::InitDelayLines(float sr, T *buf, size_t size)
 {
     i_sample_rate_ = sr;
     sample_rate_   = sr;
@@ -52,20 +77,36 @@ int ReverbSc::Init(float sr)
     i_skip_init_   = 0;
     damp_fact_     = 1.0;
     prv_lpfreq_    = 0.0;
-    init_done_     = 1;
-    int i, n_bytes = 0;
-    n_bytes = 0;
-    for(i = 0; i < 8; i++)
+    init_done_     = 0;
+    // the shortest line delays the first output by about 40 ms
+    silence_.Init(sr, 0.1f);
+    if(buf == nullptr)
+        return 1;
+    // lines are packed back to back, offsets are in samples
+    size_t offset = 0;
+    for(int i = 0; i < 8; i++)
     {
-        if(n_bytes > DSY_REVERBSC_MAX_SIZE)
+        size_t n_samples = DelayLineMaxSamples(sr, 1, i);
+        if(offset + n_samples > size)
             return 1;
-        delay_lines_[i].buf = (aux_) + n_bytes;
+        delay_lines_[i].buf = buf + offset;
         InitDelayLine(&delay_lines_[i], i);
-        n_bytes += DelayLineBytesAlloc(sr, 1, i);
+        offset += n_samples;
     }
+    init_done_ = 1;
     return 0;
 }
 
+static size_t TotalDelaySamples(float sr)
+{
+    size_t size = 0;
+    for(int i = 0; i < 8; i++)
+    {
+        size += DelayLineMaxSamples(sr, 1, i);
+    }
+    return size;
+}
+
 static int DelayLineMaxSamples(float sr, float i_pitch_mod, int n)
 {
     float max_del;
@@ -75,15 +116,8 @@ static int DelayLineMaxSamples(float sr, float i_pitch_mod, int n)
     return (int)(max_del * sr + 16.5);
 }
 
-static int DelayLineBytesAlloc(float sr, float i_pitch_mod, int n)
-{
-    int n_bytes = 0;
-
-    n_bytes += (DelayLineMaxSamples(sr, i_pitch_mod, n) * (int)sizeof(float));
-    return n_bytes;
-}
-
-void ReverbSc::NextRandomLineseg(ReverbScDl *lp, int n)
+template <typename T>
+void ReverbScT<T>::NextRandomLineseg(ReverbScDlT<T> *lp, int n)
 {
     float prv_del, nxt_del, phs_inc_val;
 
@@ -110,7 +144,8 @@ void ReverbSc::NextRandomLineseg(ReverbScDl *lp, int n)
     lp->read_pos_frac_inc = (int)(phs_inc_val * DELAYPOS_SCALE + 0.5);
 }
 
-int ReverbSc::InitDelayLine(ReverbScDl *lp, int n)
+template <typename T>
+int ReverbScT<T>::InitDelayLine(ReverbScDlT<T> *lp, int n)
 {
     float read_pos;
     /* int     i; */
@@ -139,18 +174,17 @@ int ReverbSc::InitDelayLine(ReverbScDl *lp, int n)
     return REVSC_OK;
 }
 
-int ReverbSc::Process(const float &in1,
-                      const float &in2,
-                      float *      out1,
-                      float *      out2)
+template <typename T>
+int ReverbScT<T>::Process(const T &in1, const T &in2, T *out1, T *out2)
 {
-    float       a_in_l, a_in_r, a_out_l, a_out_r;
-    float       vm1, v0, v1, v2, am1, a0, a1, a2, frac;
-    ReverbScDl *lp;
-    int         read_pos;
-    uint32_t    n;
-    int         buffer_size; /* Local copy */
-    float       damp_fact = damp_fact_;
+    DSY_PROFILE_SCOPE("ReverbSc::Process");
+    T               a_in_l, a_in_r, a_out_l, a_out_r;
+    T               vm1, v0, v1, v2, am1, a0, a1, a2, frac;
+    ReverbScDlT<T> *lp;
+    int             read_pos;
+    uint32_t        n;
+    int             buffer_size; /* Local copy */
+    T               damp_fact = damp_fact_;
 
     //if (init_done_ <= 0) return REVSC_NOT_OK;
     if(init_done_ <= 0)
@@ -160,10 +194,10 @@ int ReverbSc::Process(const float &in1,
     if(lpfreq_ != prv_lpfreq_)
     {
         prv_lpfreq_ = lpfreq_;
-        damp_fact
-            = 2.0f - cosf(prv_lpfreq_ * (2.0f * (float)M_PI) / sample_rate_);
+        const T w = T(prv_lpfreq_) * (T(2) * (T)M_PI) / sample_rate_;
+        damp_fact = T(2) - std::cos(w);
         damp_fact = damp_fact_
-            = damp_fact - sqrtf(damp_fact * damp_fact - 1.0f);
+            = damp_fact - std::sqrt(damp_fact * damp_fact - T(1));
     }
 
     /* calculate "resultant junction pressure" and mix to input signals */
@@ -187,7 +221,7 @@ int ReverbSc::Process(const float &in1,
         /* send input signal and feedback to delay line */
 
         lp->buf[lp->write_pos]
-            = (float)((n & 1 ? a_in_r : a_in_l) - lp->filter_state);
+            = (T)((n & 1 ? a_in_r : a_in_l) - lp->filter_state);
         if(++lp->write_pos >= buffer_size)
         {
             lp->write_pos -= buffer_size;
@@ -203,7 +237,7 @@ int ReverbSc::Process(const float &in1,
         if(lp->read_pos >= buffer_size)
             lp->read_pos -= buffer_size;
         read_pos = lp->read_pos;
-        frac     = (float)lp->read_pos_frac * (1.0 / (float)DELAYPOS_SCALE);
+        frac     = (T)lp->read_pos_frac * (T(1) / (T)DELAYPOS_SCALE);
 
         /* calculate interpolation coefficients */
 
@@ -223,10 +257,10 @@ int ReverbSc::Process(const float &in1,
 
         if(read_pos > 0 && read_pos < (buffer_size - 2))
         {
-            vm1 = (float)(lp->buf[read_pos - 1]);
-            v0  = (float)(lp->buf[read_pos]);
-            v1  = (float)(lp->buf[read_pos + 1]);
-            v2  = (float)(lp->buf[read_pos + 2]);
+            vm1 = lp->buf[read_pos - 1];
+            v0  = lp->buf[read_pos];
+            v1  = lp->buf[read_pos + 1];
+            v2  = lp->buf[read_pos + 2];
         }
         else
         {
@@ -234,16 +268,16 @@ int ReverbSc::Process(const float &in1,
 
             if(--read_pos < 0)
                 read_pos += buffer_size;
-            vm1 = (float)lp->buf[read_pos];
+            vm1 = lp->buf[read_pos];
             if(++read_pos >= buffer_size)
                 read_pos -= buffer_size;
-            v0 = (float)lp->buf[read_pos];
+            v0 = lp->buf[read_pos];
             if(++read_pos >= buffer_size)
                 read_pos -= buffer_size;
-            v1 = (float)lp->buf[read_pos];
+            v1 = lp->buf[read_pos];
             if(++read_pos >= buffer_size)
                 read_pos -= buffer_size;
-            v2 = (float)lp->buf[read_pos];
+            v2 = lp->buf[read_pos];
         }
         v0 = (am1 * vm1 + a0 * v0 + a1 * v1 + a2 * v2) * frac + v0;
 
@@ -253,8 +287,9 @@ int ReverbSc::Process(const float &in1,
 
         /* apply feedback gain and lowpass filter */
 
-        v0 *= (float)feedback_;
+        v0 *= (T)feedback_;
         v0               = (lp->filter_state - v0) * damp_fact + v0;
+        v0               = FlushDenormal(v0);
         lp->filter_state = v0;
 
         /* mix to output */
@@ -279,5 +314,31 @@ int ReverbSc::Process(const float &in1,
 
     *out1 = a_out_l * kOutputGain;
     *out2 = a_out_r * kOutputGain;
+    const T peak = std::fmax(std::fmax(std::fabs(in1), std::fabs(in2)),
+                             std::fmax(std::fabs(*out1), std::fabs(*out2)));
+    silence_.Process((float)peak);
     return REVSC_OK;
 }
+
+template <typename T>
+float ReverbScT<T>::GetTailLength() const
+{
+    if(feedback_ >= 1.0f)
+    {
+        return INFINITY;
+    }
+    float mean_delay = 0.0f;
+    for(int i = 0; i < 8; i++)
+    {
+        mean_delay += kReverbParams[i][0] * 0.125f;
+    }
+    if(feedback_ <= 0.0f)
+    {
+        return mean_delay;
+    }
+    // each pass through a line loses -20 log10(feedback) dB
+    return mean_delay * -3.0f / log10f(feedback_);
+}
+
+template class daisysp::ReverbScT<float>;
+template class daisysp::ReverbScT<double>;
@@ -2,13 +2,18 @@
 #ifndef DSYSP_REVERBSC_H
 #define DSYSP_REVERBSC_H
 
+#include <stddef.h>
+#include "Utility/allocator.h"
+#include "Utility/silencedetector.h"
+
 #define DSY_REVERBSC_MAX_SIZE 98936
 
 namespace daisysp
 {
 /**Delay line for internal reverb use
 */
-typedef struct
+template <typename T>
+struct ReverbScDlT
 {
     int    write_pos;         /**< write position */
     int    buffer_size;       /**< buffer size */
@@ -18,9 +23,11 @@ typedef struct
     int    dummy;             /**<  dummy var */
     int    seed_val;          /**< randseed */
     int    rand_line_cnt;     /**< number of random lines */
-    float  filter_state;      /**< state of filter */
-    float *buf;               /**< buffer ptr */
-} ReverbScDl;
+    T      filter_state;      /**< state of filter */
+    T *    buf;               /**< buffer ptr */
+};
+
+using ReverbScDl = ReverbScDlT<float>;
 
 /** Stereo Reverb
 
@@ -33,20 +40,36 @@ Year:                    1999, 2005
 Ported to soundpipe by:  Paul Batchelor
 
 Ported by:                Stephen Hensley
+
+The delay lines, filters and signal path use the sample type T, float or
+double. ReverbSc is the float version. ReverbScT<double> takes twice the
+delay memory and keeps the long feedback loop in double precision.
 */
-class ReverbSc
+template <typename T = float>
+class ReverbScT
 {
   public:
-    ReverbSc() {}
-    ~ReverbSc() {}
+    ReverbScT() {}
+    ~ReverbScT() {}
+#ifndef DSY_NO_EMBEDDED_BUFFERS
     /** Initializes the reverb module, and sets the sample_rate at which the Process function will be called.
         Returns 0 if all good, or 1 if it runs out of delay times exceed maximum allowed.
     */
     int Init(float sample_rate);
+#endif
+
+    /** Initializes the reverb module with delay memory from allocator,
+        sized exactly for sample_rate.
+        Returns 0 if all good, or 1 if the allocator is exhausted.
+    */
+    int Init(float sample_rate, Allocator &allocator);
+
+    /** Bytes Init takes from an Allocator at sample_rate */
+    static size_t GetRequiredMemory(float sample_rate);
 
     /** Process the input through the reverb, and updates values of out1, and out2 with the new processed signal.
     */
-    int Process(const float &in1, const float &in2, float *out1, float *out2);
+    int Process(const T &in1, const T &in2, T *out1, T *out2);
 
     /** controls the reverb time. reverb tail becomes infinite when set to 1.0
         \param fb - sets reverb time. range: 0.0 to 1.0
@@ -57,19 +80,37 @@ class ReverbSc
     */
     inline void SetLpFreq(const float &freq) { lpfreq_ = freq; }
 
+    /** True once input and output have stayed below -80 dBFS for 100 ms.
+        Process may then be skipped, and the output zero-filled, for as
+        long as the input stays silent.
+    */
+    inline bool IsSilent() const { return silence_.IsSilent(); }
+
+    /** Seconds for the tail to decay by 60 dB once the input stops,
+        estimated from the feedback and the mean delay length.
+        Infinite when feedback is 1.0.
+    */
+    float GetTailLength() const;
+
   private:
-    void       NextRandomLineseg(ReverbScDl *lp, int n);
-    int        InitDelayLine(ReverbScDl *lp, int n);
-    float      feedback_, lpfreq_;
-    float      i_sample_rate_, i_pitch_mod_, i_skip_init_;
-    float      sample_rate_;
-    float      damp_fact_;
-    float      prv_lpfreq_;
-    int        init_done_;
-    ReverbScDl delay_lines_[8];
-    float      aux_[DSY_REVERBSC_MAX_SIZE];
+    void           NextRandomLineseg(ReverbScDlT<T> *lp, int n);
+    int            InitDelayLine(ReverbScDlT<T> *lp, int n);
+    int            InitDelayLines(float sr, T *buf, size_t size);
+    float          feedback_, lpfreq_;
+    float          i_sample_rate_, i_pitch_mod_, i_skip_init_;
+    float          sample_rate_;
+    T              damp_fact_;
+    float          prv_lpfreq_;
+    int            init_done_;
+    ReverbScDlT<T> delay_lines_[8];
+    SilenceDetector silence_;
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    T aux_[DSY_REVERBSC_MAX_SIZE];
+#endif
 };
 
+using ReverbSc = ReverbScT<float>;
+
 
 } // namespace daisysp
 #endif
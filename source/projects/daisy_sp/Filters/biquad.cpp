@@ -1,11 +1,13 @@
 #include "biquad.h"
 #include <math.h>
 #include "dsp.h"
+#include "profile.h"
 
 using namespace daisysp;
 
 void Biquad::Reset()
 {
+    DSY_PROFILE_SCOPE("Biquad::Reset");
     float con   = cutoff_ * two_pi_d_sr_;
     float alpha = 1.0f - 2.0f * res_ * cosf(con) * cosf(con)
                   + res_ * res_ * cosf(2 * con);
@@ -38,6 +40,7 @@ void Biquad::Init(float sample_rate)
 
 float Biquad::Process(float in)
 {
+    DSY_PROFILE_SCOPE("Biquad::Process");
     float xn, yn;
     float a0 = a0_, a1 = a1_, a2 = a2_;
     float b0 = b0_, b1 = b1_, b2 = b2_;
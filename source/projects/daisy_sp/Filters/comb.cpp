@@ -1,5 +1,6 @@
 #include "comb.h"
 #include <math.h>
+#include "denormal.h"
 
 using namespace daisysp;
 
@@ -17,6 +18,7 @@ void Comb::Init(float sample_rate, float* buff, size_t size)
     prvt_          = 0.0f;
     coef_          = 0.0f;
     buf_pos_       = 0;
+    silence_.Init(sample_rate_, loop_time_ + 0.05f);
 }
 
 float Comb::Process(float in)
@@ -41,10 +43,11 @@ float Comb::Process(float in)
 
     // internal delay line
     outsamp                = buf_[(buf_pos_ + mod_) % max_size_];
-    tmp                    = (outsamp * coef) + in;
+    tmp                    = FlushDenormal((outsamp * coef) + in);
     buf_[(size_t)buf_pos_] = tmp;
     buf_pos_               = (buf_pos_ - 1 + max_size_) % max_size_;
 
+    silence_.Process(fmaxf(fabsf(in), fabsf(outsamp)));
     return outsamp;
 }
 
@@ -54,6 +57,8 @@ void Comb::SetPeriod(float looptime)
     {
         loop_time_ = fminf(looptime, max_loop_time_);
         mod_       = loop_time_ * sample_rate_;
+        // the loop delays the echo of any input by loop_time_
+        silence_.SetHoldTime(loop_time_ + 0.05f);
         if(mod_ > max_size_)
         {
             mod_ = max_size_ - 1;
@@ -4,6 +4,7 @@
 #ifdef __cplusplus
 
 #include "Utility/dsp.h"
+#include "Utility/silencedetector.h"
 
 namespace daisysp
 {
@@ -50,10 +51,21 @@ class Comb
     */
     inline void SetRevTime(float revtime) { rev_time_ = revtime; }
 
+    /** True once input and output have stayed below -80 dBFS for the loop
+        time plus 50 ms. Process may then be skipped, and the output
+        zero-filled, for as long as the input stays silent.
+    */
+    inline bool IsSilent() const { return silence_.IsSilent(); }
+
+    /** Seconds for the output to decay by 60 dB once the input stops */
+    inline float GetTailLength() const { return rev_time_; }
+
   private:
     float  sample_rate_, rev_time_, loop_time_, prvt_, coef_, max_loop_time_;
     float* buf_;
     size_t buf_pos_, mod_, max_size_;
+
+    SilenceDetector silence_;
 };
 } // namespace daisysp
 
@@ -1,9 +1,13 @@
+#include <cmath>
 #include "moogladder.h"
 #include "dsp.h"
+#include "denormal.h"
+#include "profile.h"
 
 using namespace daisysp;
 
-float MoogLadder::my_tanh(float x)
+template <typename T>
+T MoogLadderT<T>::my_tanh(T x)
 {
     int sign = 1;
     if(x < 0)
@@ -12,18 +16,19 @@ float MoogLadder::my_tanh(float x)
         x    = -x;
         return x * sign;
     }
-    else if(x >= 4.0f)
+    else if(x >= T(4))
     {
         return sign;
     }
-    else if(x < 0.5f)
+    else if(x < T(0.5))
     {
         return x * sign;
     }
-    return sign * tanhf(x);
+    return sign * std::tanh(x);
 }
 
-void MoogLadder::Init(float sample_rate)
+template <typename T>
+void MoogLadderT<T>::Init(float sample_rate)
 {
     sample_rate_ = sample_rate;
     istor_       = 0.0f;
@@ -40,35 +45,40 @@ void MoogLadder::Init(float sample_rate)
     old_res_  = -1.0f;
 }
 
-float MoogLadder::Process(float in)
+template <typename T>
+T MoogLadderT<T>::Process(T in)
 {
-    float  freq = freq_;
-    float  res  = res_;
-    float  res4;
-    float* delay   = delay_;
-    float* tanhstg = tanhstg_;
-    float  stg[4];
-    float  acr, tune;
+    DSY_PROFILE_SCOPE("MoogLadder::Process");
+    T  freq = freq_;
+    T  res  = res_;
+    T  res4;
+    T* delay   = delay_;
+    T* tanhstg = tanhstg_;
+    T  stg[4];
+    T  acr, tune;
 
-    float THERMAL = 0.000025;
+    const T THERMAL = 0.000025;
+    // anything smaller goes subnormal once scaled by THERMAL
+    const T FLUSH = 1e-20;
 
     if(res < 0)
     {
         res = 0;
     }
 
-    if(old_freq_ != freq || old_res_ != res)
+    if(old_freq_ != freq_ || old_res_ != res)
     {
-        float f, fc, fc2, fc3, fcr;
-        old_freq_ = freq;
+        DSY_PROFILE_SCOPE("MoogLadder::Coefficients");
+        T f, fc, fc2, fc3, fcr;
+        old_freq_ = freq_;
         fc        = (freq / sample_rate_);
-        f         = 0.5f * fc;
+        f         = T(0.5) * fc;
         fc2       = fc * fc;
         fc3       = fc2 * fc2;
 
-        fcr  = 1.8730f * fc3 + 0.4955f * fc2 - 0.6490f * fc + 0.9988f;
-        acr  = -3.9364f * fc2 + 1.8409f * fc + 0.9968f;
-        tune = (1.0f - expf(-((2 * PI_F) * f * fcr))) / THERMAL;
+        fcr  = T(1.8730) * fc3 + T(0.4955) * fc2 - T(0.6490) * fc + T(0.9988);
+        acr  = T(-3.9364) * fc2 + T(1.8409) * fc + T(0.9968);
+        tune = (T(1) - std::exp(-((2 * T(PI_F)) * f * fcr))) / THERMAL;
 
         old_res_  = res;
         old_acr_  = acr;
@@ -81,7 +91,8 @@ float MoogLadder::Process(float in)
         tune = old_tune_;
     }
 
-    res4 = 4.0f * res * acr;
+    res4 = T(4) * res * acr;
+    in   = FlushBelow(in, FLUSH);
 
     for(int j = 0; j < 2; j++)
     {
@@ -98,8 +109,21 @@ float MoogLadder::Process(float in)
                                         : my_tanh(delay[k] * THERMAL)));
             delay[k] = stg[k];
         }
-        delay[5] = (stg[3] + delay[4]) * 0.5f;
+        delay[5] = (stg[3] + delay[4]) * T(0.5);
         delay[4] = stg[3];
     }
+    // the thermal scaling pushes the stage terms subnormal long before
+    // the state itself is, so flush the state well above that
+    for(int i = 0; i < 6; i++)
+    {
+        delay[i] = FlushBelow(delay[i], FLUSH);
+    }
+    for(int i = 0; i < 3; i++)
+    {
+        tanhstg[i] = FlushBelow(tanhstg[i], FLUSH);
+    }
     return delay[5];
 }
+
+template class daisysp::MoogLadderT<float>;
+template class daisysp::MoogLadderT<double>;
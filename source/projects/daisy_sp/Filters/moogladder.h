@@ -13,12 +13,17 @@ Ported from soundpipe
 
 Original author(s) : Victor Lazzarini, John ffitch (fast tanh), Bob Moog
 
+The ladder state and signal path use the sample type T, float or double.
+MoogLadder is the float version, MoogLadderT<double> keeps the feedback in
+double precision for hosts that run 64-bit buffers.
+
 */
-class MoogLadder
+template <typename T = float>
+class MoogLadderT
 {
   public:
-    MoogLadder() {}
-    ~MoogLadder() {}
+    MoogLadderT() {}
+    ~MoogLadderT() {}
     /** Initializes the MoogLadder module.
         sample_rate - The sample rate of the audio engine being run. 
     */
@@ -27,7 +32,7 @@ class MoogLadder
 
     /** Processes the lowpass filter
     */
-    float Process(float in);
+    T Process(T in);
 
     /** 
         Sets the cutoff frequency or half-way point of the filter.
@@ -41,10 +46,12 @@ class MoogLadder
     inline void SetRes(float res) { res_ = res; }
 
   private:
-    float istor_, res_, freq_, delay_[6], tanhstg_[3], old_freq_, old_res_,
-        sample_rate_, old_acr_, old_tune_;
-    float my_tanh(float x);
+    float istor_, res_, freq_, old_freq_, old_res_, sample_rate_;
+    T     delay_[6], tanhstg_[3], old_acr_, old_tune_;
+    T     my_tanh(T x);
 };
+
+using MoogLadder = MoogLadderT<float>;
 } // namespace daisysp
 #endif
 #endif
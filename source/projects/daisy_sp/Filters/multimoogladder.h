@@ -0,0 +1,184 @@
+#pragma once
+#ifndef DSY_MULTIMOOGLADDER_H
+#define DSY_MULTIMOOGLADDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include "Utility/dsp.h"
+#include "Utility/denormal.h"
+#ifdef __cplusplus
+
+/** @file multimoogladder.h */
+
+namespace daisysp
+{
+/**
+       @brief Bank of independent MoogLadder filters stored structure-of-arrays
+       @date Oct 2026
+       Same topology as MoogLadder, with the ladder stages held in parallel
+       arrays so that each stage update runs across all channels at once. \n
+       Coefficients are refreshed at the start of ProcessBlock, only for
+       channels whose frequency or resonance changed. \n
+       The stage saturator is a clamped SoftLimit instead of tanhf above
+       0.5 so it vectorizes. With the ladder's thermal scaling that region
+       is only reached by inputs far above full scale.
+*/
+template <size_t max_channels>
+class MultiMoogLadder
+{
+  public:
+    MultiMoogLadder() {}
+    ~MultiMoogLadder() {}
+
+    /** Initializes all channels
+        \param sample_rate Audio engine sample rate
+    */
+    void Init(float sample_rate)
+    {
+        sample_rate_  = sample_rate;
+        num_channels_ = max_channels;
+        for(size_t ch = 0; ch < max_channels; ch++)
+        {
+            freq_[ch]     = 1000.0f;
+            res_[ch]      = 0.4f;
+            old_freq_[ch] = 0.0f;
+            old_res_[ch]  = -1.0f;
+            for(int i = 0; i < 6; i++)
+            {
+                delay_[i][ch] = 0.0f;
+            }
+            for(int i = 0; i < 3; i++)
+            {
+                tanhstg_[i][ch] = 0.0f;
+            }
+        }
+    }
+
+    /** Sets the number of channels processed by ProcessBlock
+        \param num Clamped to max_channels
+    */
+    inline void SetNumChannels(size_t num)
+    {
+        num_channels_ = num < max_channels ? num : max_channels;
+    }
+
+    /** Returns the number of channels processed by ProcessBlock */
+    inline size_t GetNumChannels() const { return num_channels_; }
+
+    /** Sets the cutoff frequency of one channel in Hz */
+    inline void SetFreq(size_t ch, float freq) { freq_[ch] = freq; }
+
+    /** Sets the resonance of one channel */
+    inline void SetRes(size_t ch, float res) { res_[ch] = res; }
+
+    /** Filters a block for every active channel.
+        \param in one buffer of size samples per channel
+        \param out one buffer of size samples per channel, may alias in
+        \param size number of samples
+    */
+    void ProcessBlock(const float *const *in, float **out, size_t size)
+    {
+        const size_t nch = num_channels_;
+        UpdateCoefficients();
+
+        float x[max_channels];
+        float stg[4][max_channels];
+        for(size_t i = 0; i < size; i++)
+        {
+            for(size_t ch = 0; ch < nch; ch++)
+            {
+                x[ch] = FlushBelow(in[ch][i], kFlush);
+            }
+            for(int j = 0; j < 2; j++)
+            {
+                for(size_t ch = 0; ch < nch; ch++)
+                {
+                    const float s = x[ch] - res4_[ch] * delay_[5][ch];
+                    delay_[0][ch] = stg[0][ch]
+                        = delay_[0][ch]
+                          + tune_[ch] * (Sat(s * kThermal) - tanhstg_[0][ch]);
+                }
+                for(int k = 1; k < 4; k++)
+                {
+                    for(size_t ch = 0; ch < nch; ch++)
+                    {
+                        const float t     = Sat(stg[k - 1][ch] * kThermal);
+                        const float other = k != 3
+                                                ? tanhstg_[k][ch]
+                                                : Sat(delay_[k][ch] * kThermal);
+                        tanhstg_[k - 1][ch] = t;
+                        stg[k][ch] = delay_[k][ch] + tune_[ch] * (t - other);
+                        delay_[k][ch] = stg[k][ch];
+                    }
+                }
+                for(size_t ch = 0; ch < nch; ch++)
+                {
+                    delay_[5][ch] = (stg[3][ch] + delay_[4][ch]) * 0.5f;
+                    delay_[4][ch] = stg[3][ch];
+                    // MoogLadder carries the last stage input into the
+                    // second pass, keep that so both sound the same
+                    x[ch] = stg[2][ch];
+                }
+            }
+            for(size_t ch = 0; ch < nch; ch++)
+            {
+                for(int k = 0; k < 6; k++)
+                {
+                    delay_[k][ch] = FlushBelow(delay_[k][ch], kFlush);
+                }
+                for(int k = 0; k < 3; k++)
+                {
+                    tanhstg_[k][ch] = FlushBelow(tanhstg_[k][ch], kFlush);
+                }
+                out[ch][i] = delay_[5][ch];
+            }
+        }
+    }
+
+  private:
+    static constexpr float kThermal = 0.000025f;
+    // anything smaller goes subnormal once scaled by kThermal
+    static constexpr float kFlush = 1e-20f;
+
+    static inline float Sat(float x)
+    {
+        // matches MoogLadder: linear below 0.5 and for negative input
+        return x < 0.5f ? x : SoftLimit(fmin(x, 3.0f));
+    }
+
+    void UpdateCoefficients()
+    {
+        for(size_t ch = 0; ch < num_channels_; ch++)
+        {
+            const float res = fmax(res_[ch], 0.0f);
+            if(old_freq_[ch] == freq_[ch] && old_res_[ch] == res)
+            {
+                continue;
+            }
+            old_freq_[ch]  = freq_[ch];
+            old_res_[ch]   = res;
+            const float fc  = freq_[ch] / sample_rate_;
+            const float f   = 0.5f * fc;
+            const float fc2 = fc * fc;
+            const float fc3 = fc2 * fc2;
+            const float fcr
+                = 1.8730f * fc3 + 0.4955f * fc2 - 0.6490f * fc + 0.9988f;
+            const float acr = -3.9364f * fc2 + 1.8409f * fc + 0.9968f;
+            tune_[ch] = (1.0f - expf(-((2 * PI_F) * f * fcr))) / kThermal;
+            res4_[ch] = 4.0f * res * acr;
+        }
+    }
+
+    float  sample_rate_;
+    size_t num_channels_;
+    float  freq_[max_channels], res_[max_channels];
+    float  old_freq_[max_channels], old_res_[max_channels];
+    float  tune_[max_channels], res4_[max_channels];
+    float  delay_[6][max_channels];
+    float  tanhstg_[3][max_channels];
+};
+
+} // namespace daisysp
+#endif
+#endif
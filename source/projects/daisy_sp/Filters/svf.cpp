@@ -1,6 +1,7 @@
 #include <math.h>
 #include "svf.h"
 #include "dsp.h"
+#include "profile.h"
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
 using namespace daisysp;
@@ -10,6 +11,7 @@ void Svf::Init(float sample_rate)
     sr_        = sample_rate;
     fc_        = 200.0f;
     res_       = 0.5f;
+    res_damp_  = 2.0f * (1.0f - powf(res_, 0.25f));
     drive_     = 0.5f;
     pre_drive_ = 0.5f;
     freq_      = 0.25f;
@@ -30,6 +32,7 @@ void Svf::Init(float sample_rate)
 
 void Svf::Process(float in)
 {
+    DSY_PROFILE_SCOPE("Svf::Process");
     input_ = in;
     // first pass
     notch_ = input_ - damp_ * band_;
@@ -57,24 +60,25 @@ void Svf::Process(float in)
 
 void Svf::SetFreq(float f)
 {
+    DSY_PROFILE_SCOPE("Svf::SetFreq");
     fc_ = fclamp(f, 1.0e-6, fc_max_);
     // Set Internal Frequency for fc_
     freq_ = 2.0f
             * sinf(PI_F
                    * MIN(0.25f,
                          fc_ / (sr_ * 2.0f))); // fs*2 because double sampled
-    // recalculate damp
-    damp_ = MIN(2.0f * (1.0f - powf(res_, 0.25f)),
-                MIN(2.0f, 2.0f / freq_ - freq_ * 0.5f));
+    // recalculate damp, resonance term is cached by SetRes
+    damp_ = MIN(res_damp_, MIN(2.0f, 2.0f / freq_ - freq_ * 0.5f));
 }
 
 void Svf::SetRes(float r)
 {
+    DSY_PROFILE_SCOPE("Svf::SetRes");
     float res = fclamp(r, 0.f, 1.f);
     res_      = res;
+    res_damp_ = 2.0f * (1.0f - powf(res_, 0.25f));
     // recalculate damp
-    damp_  = MIN(2.0f * (1.0f - powf(res_, 0.25f)),
-                MIN(2.0f, 2.0f / freq_ - freq_ * 0.5f));
+    damp_  = MIN(res_damp_, MIN(2.0f, 2.0f / freq_ - freq_ * 0.5f));
     drive_ = pre_drive_ * res_;
 }
 
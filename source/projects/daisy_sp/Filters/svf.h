@@ -2,6 +2,10 @@
 #ifndef DSY_SVF_H
 #define DSY_SVF_H
 
+#include <stddef.h>
+#include "Utility/dsp.h"
+#include "Utility/profile.h"
+
 namespace daisysp
 {
 /**      Double Sampled, Stable State Variable Filter
@@ -18,6 +22,16 @@ Ported by: Stephen Hensley
 class Svf
 {
   public:
+    /** Selects the response rendered by ProcessBlock */
+    enum class Output
+    {
+        LOW,
+        HIGH,
+        BAND,
+        NOTCH,
+        PEAK,
+    };
+
     Svf() {}
     ~Svf() {}
     /** Initializes the filter
@@ -31,6 +45,58 @@ class Svf
     */
     void Process(float in);
 
+    /** Process a block of audio, rendering only the selected output.
+        Filter state is kept in registers for the length of the block.
+        The Low()/High()/... accessors are not updated by this call.
+        \param in input buffer
+        \param out output buffer, may alias in
+        \param size number of samples to process
+    */
+    template <Output output>
+    void ProcessBlock(const float *in, float *out, size_t size)
+    {
+        DSY_PROFILE_SCOPE("Svf::ProcessBlock");
+        const float freq = freq_, damp = damp_, drive = drive_;
+        float       low = low_, band = band_;
+        for(size_t i = 0; i < size; i++)
+        {
+            out[i] = Tick<output>(in[i], freq, damp, drive, low, band);
+        }
+        low_  = low;
+        band_ = band;
+    }
+
+    /** Process a block of audio with an audio-rate cutoff.
+        The coefficients are recomputed every sample with a polynomial
+        approximation in place of the sinf used by SetFreq.
+        \param in input buffer
+        \param freq cutoff frequency in Hz for each sample
+        \param out output buffer, may alias in
+        \param size number of samples to process
+    */
+    template <Output output>
+    void
+    ProcessBlock(const float *in, const float *freq, float *out, size_t size)
+    {
+        DSY_PROFILE_SCOPE("Svf::ProcessBlock");
+        const float drive = drive_, res_damp = res_damp_;
+        const float fc_max = fc_max_, norm = 0.5f / sr_;
+        float       low = low_, band = band_;
+        float       fc = fc_, f = freq_, damp = damp_;
+        for(size_t i = 0; i < size; i++)
+        {
+            fc   = fclamp(freq[i], 1.0e-6f, fc_max);
+            f    = FastFreqCoeff(fc * norm);
+            damp = fmin(res_damp, fmin(2.0f, 2.0f / f - f * 0.5f));
+            out[i] = Tick<output>(in[i], f, damp, drive, low, band);
+        }
+        low_  = low;
+        band_ = band;
+        fc_   = fc;
+        freq_ = f;
+        damp_ = damp;
+    }
+
 
     /** sets the frequency of the cutoff frequency. 
         f must be between 0.0 and sample_rate / 3
@@ -68,7 +134,56 @@ class Svf
     inline float Peak() { return out_peak_; }
 
   private:
+    template <Output output>
+    static inline float Tick(float  in,
+                             float  freq,
+                             float  damp,
+                             float  drive,
+                             float &low,
+                             float &band)
+    {
+        // first pass
+        float notch = in - damp * band;
+        low         = low + freq * band;
+        float high  = notch - low;
+        band        = freq * high + band - drive * band * band * band;
+        float out   = Select<output>(notch, low, high, band);
+        // second pass
+        notch = in - damp * band;
+        low   = low + freq * band;
+        high  = notch - low;
+        band  = freq * high + band - drive * band * band * band;
+        // average both passes
+        return 0.5f * (out + Select<output>(notch, low, high, band));
+    }
+
+    template <Output output>
+    static inline float Select(float notch, float low, float high, float band)
+    {
+        switch(output)
+        {
+            case Output::LOW: return low;
+            case Output::HIGH: return high;
+            case Output::BAND: return band;
+            case Output::NOTCH: return notch;
+            case Output::PEAK:
+            default: return low - high;
+        }
+    }
+
+    /** 2 * sin(pi * x) for x in [0, 0.25], with x clamped to that range.
+        5th order odd polynomial, max error ~7e-5 at x = 0.25.
+    */
+    static inline float FastFreqCoeff(float x)
+    {
+        const float w  = PI_F * fmin(x, 0.25f);
+        const float w2 = w * w;
+        return 2.0f * w
+               * (1.0f + w2 * (-1.0f / 6.0f + w2 * (1.0f / 120.0f)));
+    }
+
     float sr_, fc_, res_, drive_, freq_, damp_;
+    float res_damp_;
     float notch_, low_, high_, band_, peak_;
     float input_;
     float out_low_, out_high_, out_band_, out_peak_, out_notch_;
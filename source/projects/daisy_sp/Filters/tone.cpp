@@ -1,6 +1,7 @@
 #include "tone.h"
 #include <math.h>
 #include "dsp.h"
+#include "denormal.h"
 
 using namespace daisysp;
 
@@ -18,7 +19,7 @@ float Tone::Process(float in)
     float out;
 
     out      = c1_ * in + c2_ * prevout_;
-    prevout_ = out;
+    prevout_ = FlushDenormal(out);
 
     return out;
 }
@@ -8,9 +8,9 @@ void GrainletOscillator::Init(float sample_rate)
 {
     sample_rate_ = sample_rate;
 
-    carrier_phase_ = 0.0f;
-    formant_phase_ = 0.0f;
-    next_sample_   = 0.0f;
+    carrier_phase_.Init();
+    formant_phase_.Init();
+    next_sample_ = 0.0f;
 
     carrier_shape_ = 0.f;
     carrier_bleed_ = 0.f;
@@ -26,19 +26,17 @@ float GrainletOscillator::Process()
     float this_sample = next_sample_;
     float next_sample = 0.0f;
 
-    carrier_phase_ += carrier_frequency_;
-
-    if(carrier_phase_ >= 1.0f)
+    if(carrier_phase_.Advance())
     {
-        carrier_phase_ -= 1.0f;
-        float reset_time = carrier_phase_ / carrier_frequency_;
+        float reset_time = carrier_phase_.GetPhase() / carrier_frequency_;
 
         float shape_inc = new_carrier_shape_ - carrier_shape_;
         float bleed_inc = new_carrier_bleed_ - carrier_bleed_;
 
         float before = Grainlet(
             1.0f,
-            formant_phase_ + (1.0f - reset_time) * formant_frequency_,
+            formant_phase_.GetPhase()
+                + (1.0f - reset_time) * formant_frequency_,
             new_carrier_shape_ + shape_inc * (1.0f - reset_time),
             new_carrier_bleed_ + bleed_inc * (1.0f - reset_time));
 
@@ -48,35 +46,34 @@ float GrainletOscillator::Process()
         float discontinuity = after - before;
         this_sample += discontinuity * ThisBlepSample(reset_time);
         next_sample += discontinuity * NextBlepSample(reset_time);
-        formant_phase_ = reset_time * formant_frequency_;
+        formant_phase_.Reset(reset_time * formant_frequency_);
     }
     else
     {
-        formant_phase_ += formant_frequency_;
-        if(formant_phase_ >= 1.0f)
-        {
-            formant_phase_ -= 1.0f;
-        }
+        formant_phase_.Advance();
     }
 
     carrier_bleed_ = new_carrier_bleed_;
     carrier_shape_ = new_carrier_shape_;
-    next_sample += Grainlet(
-        carrier_phase_, formant_phase_, carrier_shape_, carrier_bleed_);
+    next_sample += Grainlet(carrier_phase_.GetPhase(),
+                            formant_phase_.GetPhase(),
+                            carrier_shape_,
+                            carrier_bleed_);
     next_sample_ = next_sample;
     return this_sample;
 }
 
 void GrainletOscillator::SetFreq(float freq)
 {
-    carrier_frequency_ = freq / sample_rate_;
-    carrier_frequency_ = carrier_frequency_ > 0.5f ? 0.5f : carrier_frequency_;
+    carrier_frequency_ = fclamp(freq / sample_rate_, 0.0f, 0.5f);
+    carrier_phase_.SetIncrement(carrier_frequency_);
 }
 
 void GrainletOscillator::SetFormantFreq(float freq)
 {
     formant_frequency_ = freq / sample_rate_;
     formant_frequency_ = formant_frequency_ > 0.5f ? 0.5f : formant_frequency_;
+    formant_phase_.SetIncrement(formant_frequency_);
 }
 
 void GrainletOscillator::SetShape(float shape)
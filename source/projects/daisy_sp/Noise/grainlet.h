@@ -3,6 +3,7 @@
 #define DSY_GRAINLET_H
 
 #include <stdint.h>
+#include "Utility/phaseaccumulator.h"
 #ifdef __cplusplus
 
 /** @file grainlet.h */
@@ -64,9 +65,9 @@ class GrainletOscillator
                    float bleed);
 
     // Oscillator state.
-    float carrier_phase_;
-    float formant_phase_;
-    float next_sample_;
+    PhaseAccumulator carrier_phase_;
+    PhaseAccumulator formant_phase_;
+    float            next_sample_;
 
     // For interpolation of parameters.
     float carrier_frequency_;
@@ -40,7 +40,7 @@ float Particle::Process()
 
             const float u = 2.0f * rand() * kRandFrac - 1.0f;
             const float f
-                = fmin(powf(2.f, kRatioFrac * spread_ * u) * frequency_, .25f);
+                = fmin(SemitonesToRatio(spread_ * u) * frequency_, .25f);
             pre_gain_ = 0.5f / sqrtf(resonance_ * f * sqrtf(density_));
             filter_.SetFreq(f * sample_rate_);
             filter_.SetRes(resonance_);
@@ -73,8 +73,7 @@ class Particle
     void SetSync(bool sync);
 
   private:
-    static constexpr float kRandFrac  = 1.f / (float)RAND_MAX;
-    static constexpr float kRatioFrac = 1.f / 12.f;
+    static constexpr float kRandFrac = 1.f / (float)RAND_MAX;
     float                  sample_rate_;
     float aux_, frequency_, density_, gain_, spread_, resonance_;
     bool  sync_;
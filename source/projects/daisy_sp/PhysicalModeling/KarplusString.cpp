@@ -1,21 +1,53 @@
 #include <cmath>
 #include "dsp.h"
 #include "KarplusString.h"
+#include "denormal.h"
 #include <stdlib.h>
 
 using namespace daisysp;
 
+#ifndef DSY_NO_EMBEDDED_BUFFERS
 void String::Init(float sample_rate)
+{
+    string_.Init(string_buffer_, kDelayLineSize);
+    stretch_.Init(stretch_buffer_, kDelayLineSize / 4);
+    InitParams(sample_rate);
+}
+#endif
+
+bool String::Init(float sample_rate, Allocator &allocator)
+{
+    const size_t size = DelayLineSize(sample_rate);
+    if(!string_.Init(allocator, size) || !stretch_.Init(allocator, size / 4))
+    {
+        return false;
+    }
+    InitParams(sample_rate);
+    return true;
+}
+
+size_t String::GetRequiredMemory(float sample_rate)
+{
+    typedef DelayLine<float, DELAYLINE_USER_MEMORY> Line;
+    const size_t size = DelayLineSize(sample_rate);
+    return Line::GetRequiredMemory(size) + Line::GetRequiredMemory(size / 4);
+}
+
+size_t String::DelayLineSize(float sample_rate)
+{
+    return (size_t)ceilf(kDelayLineSize * sample_rate / 48000.f);
+}
+
+void String::InitParams(float sample_rate)
 {
     sample_rate_ = sample_rate;
+    delay_size_  = string_.GetSize();
 
     SetFreq(440.f);
     non_linearity_amount_ = .5f;
     brightness_           = .5f;
     damping_              = .5f;
 
-    string_.Init();
-    stretch_.Init();
     Reset();
 
     SetFreq(440.f);
@@ -82,7 +114,7 @@ float String::ProcessInternal(const float in)
     float brightness = brightness_;
 
     float delay = 1.0f / frequency_;
-    delay       = fclamp(delay, 4.f, kDelayLineSize - 4.0f);
+    delay       = fclamp(delay, 4.f, delay_size_ - 4.0f);
 
     // If there is not enough delay time in the delay line, we play at the
     // lowest possible note and we upsample on the fly with a shitty linear
@@ -99,7 +131,7 @@ float String::ProcessInternal(const float in)
     float damping_cutoff
         = fmin(12.0f + damping_ * damping_ * 60.0f + brightness * 24.0f, 84.0f);
     float damping_f
-        = fmin(frequency_ * powf(2.f, damping_cutoff * kOneTwelfth), 0.499f);
+        = fmin(frequency_ * SemitonesToRatio(damping_cutoff), 0.499f);
 
     // Crossfade to infinite decay.
     if(damping_ >= 0.95f)
@@ -113,7 +145,7 @@ float String::ProcessInternal(const float in)
     float temp_f = damping_f * sample_rate_;
     iir_damping_filter_.SetFreq(temp_f);
 
-    float ratio                = powf(2.f, damping_cutoff * kOneTwelfth);
+    float ratio                = SemitonesToRatio(damping_cutoff);
     float damping_compensation = 1.f - 2.f * atanf(1.f / ratio) / (TWOPI_F);
 
     float stretch_point
@@ -185,7 +217,7 @@ float String::ProcessInternal(const float in)
 
         s = dc_blocker_.Process(s);
 
-        s = iir_damping_filter_.Process(s);
+        s = FlushDenormal(iir_damping_filter_.Process(s));
         string_.Write(s);
 
         out_sample_[1] = out_sample_[0];
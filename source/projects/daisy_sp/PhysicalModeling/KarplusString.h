@@ -31,10 +31,23 @@ class String
     String() {}
     ~String() {}
 
-    /** Initialize the module.
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    /** Initialize the module, using the built-in delay sized for 48kHz.
         \param sample_rate Audio engine sample rate
     */
     void Init(float sample_rate);
+#endif
+
+    /** Initialize the module, taking delay memory scaled to sample_rate
+        from allocator, so the lowest pitch is the same at any rate.
+        \param sample_rate Audio engine sample rate
+        \param allocator Source of the delay memory
+        \return false if the allocator is exhausted
+    */
+    bool Init(float sample_rate, Allocator &allocator);
+
+    /** Bytes Init takes from an Allocator at sample_rate */
+    static size_t GetRequiredMemory(float sample_rate);
 
     /** Clear the delay line */
     void Reset();
@@ -66,7 +79,7 @@ class String
 
 
   private:
-    static constexpr size_t kDelayLineSize = 1024;
+    static constexpr size_t kDelayLineSize = 1024; // at 48kHz
 
     enum StringNonLinearity
     {
@@ -77,8 +90,16 @@ class String
     template <String::StringNonLinearity non_linearity>
     float ProcessInternal(const float in);
 
-    DelayLine<float, kDelayLineSize>     string_;
-    DelayLine<float, kDelayLineSize / 4> stretch_;
+    static size_t DelayLineSize(float sample_rate);
+    void          InitParams(float sample_rate);
+
+    DelayLine<float, DELAYLINE_USER_MEMORY> string_;
+    DelayLine<float, DELAYLINE_USER_MEMORY> stretch_;
+    size_t                                  delay_size_;
+#ifndef DSY_NO_EMBEDDED_BUFFERS
+    float string_buffer_[kDelayLineSize];
+    float stretch_buffer_[kDelayLineSize / 4];
+#endif
 
     float frequency_, non_linearity_amount_, brightness_, damping_;
 
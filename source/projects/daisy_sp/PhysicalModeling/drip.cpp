@@ -76,6 +76,9 @@ void Drip::Init(float sample_rate, float dettack)
     shake_max_save_ = 0.0f;
     num_objects_    = 10.0f;
     finalZ0_ = finalZ1_ = finalZ2_ = 0.0f;
+    // Init starts a drip, so a fresh instance is audible
+    silence_.Init(sample_rate_);
+    silence_.Reset();
 }
 
 float Drip::Process(bool trig)
@@ -209,5 +212,6 @@ float Drip::Process(bool trig)
     lastOutput *= 0.005f;
     shake_energy_ = shakeEnergy;
     snd_level_    = sndLevel;
+    silence_.Process(lastOutput);
     return lastOutput;
 }
@@ -3,6 +3,7 @@
 #define DSY_DRIP_H
 
 #include <stdint.h>
+#include "Utility/silencedetector.h"
 #ifdef __cplusplus
 
 /**  @file drip.h */
@@ -35,6 +36,15 @@ class Drip
     */
     float Process(bool trig);
 
+    /** True once the dettack period has ended and the output has stayed
+        below -80 dBFS for 50 ms. Process may then be skipped until the
+        next trigger.
+    */
+    inline bool IsSilent() const
+    {
+        return kloop_ <= 0.0f && silence_.IsSilent();
+    }
+
   private:
     float gains0_, gains1_, gains2_, kloop_, dettack_, num_tubes_, damp_,
         shake_max_, freq_, freq1_, freq2_, amp_, snd_level_, outputs00_,
@@ -45,6 +55,8 @@ class Drip
         coeffs20_, shake_energy_, shake_damp_, shake_max_save_, num_objects_,
         sample_rate_, res_freq0_, res_freq1_, res_freq2_, inputs1_, inputs2_;
 
+    SilenceDetector silence_;
+
     int   my_random(int max);
     float noise_tick();
 };
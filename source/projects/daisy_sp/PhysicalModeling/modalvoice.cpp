@@ -12,6 +12,7 @@ void ModalVoice::Init(float sample_rate)
     resonator_.Init(0.015f, 24, sample_rate_);
     excitation_filter_.Init();
     dust_.Init();
+    silence_.Init(sample_rate_);
 
     SetSustain(false);
     SetFreq(440.f);
@@ -29,6 +30,7 @@ void ModalVoice::SetSustain(bool sustain)
 void ModalVoice::Trig()
 {
     trig_ = true;
+    silence_.Reset();
 }
 
 void ModalVoice::SetFreq(float freq)
@@ -73,9 +75,8 @@ float ModalVoice::Process(bool trigger)
     const float f      = sustain_ ? 4.0f * f0_ : 2.0f * f0_;
     const float cutoff = fmin(
         f
-            * powf(2.f,
-                   kOneTwelfth
-                       * ((brightness * (2.0f - brightness) - 0.5f) * range)),
+            * SemitonesToRatio((brightness * (2.0f - brightness) - 0.5f)
+                               * range),
         0.499f);
     const float q = sustain_ ? 0.7f : 1.5f;
 
@@ -91,9 +92,10 @@ float ModalVoice::Process(bool trigger)
     {
         const float attenuation = 1.0f - damping * 0.5f;
         const float amplitude   = (0.12f + 0.08f * accent_) * attenuation;
-        temp = amplitude * powf(2.f, kOneTwelfth * (cutoff * cutoff * 24.0f))
+        temp = amplitude * SemitonesToRatio(cutoff * cutoff * 24.0f)
                / cutoff;
         trig_ = false;
+        silence_.Reset();
     }
 
     const float one = 1.0f;
@@ -105,5 +107,7 @@ float ModalVoice::Process(bool trigger)
     resonator_.SetBrightness(brightness);
     resonator_.SetDamping(damping);
 
-    return resonator_.Process(temp);
+    const float out = resonator_.Process(temp);
+    silence_.Process(out);
+    return out;
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Filters/svf.h"
 #include "PhysicalModeling/resonator.h"
 #include "Noise/dust.h"
+#include "Utility/silencedetector.h"
 #ifdef __cplusplus
 
 /** @file modalvoice.h */
@@ -74,6 +75,11 @@ class ModalVoice
     /** Get the raw excitation signal. Must call Process() first. */
     float GetAux();
 
+    /** True once the output has stayed below -80 dBFS for 50 ms without
+        sustain. Process may then be skipped until the next trigger.
+    */
+    bool IsSilent() const { return !sustain_ && silence_.IsSilent(); }
+
   private:
     float sample_rate_;
 
@@ -85,6 +91,7 @@ class ModalVoice
     ResonatorSvf<1> excitation_filter_;
     Resonator       resonator_;
     Dust            dust_;
+    SilenceDetector silence_;
 };
 } // namespace daisysp
 #endif
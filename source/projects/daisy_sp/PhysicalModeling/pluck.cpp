@@ -42,6 +42,7 @@ void Pluck::Init(float sample_rate, float *buf, int32_t npts, int32_t mode)
     /* tuned pitch convt */
     sicps_ = (npts * 256.0f + 128.0f) * (1.0f / sample_rate_);
     init_  = 1;
+    silence_.Init(sample_rate_);
 }
 
 float Pluck::Process(float &trig)
@@ -60,6 +61,7 @@ float Pluck::Process(float &trig)
     {
         init_ = 0;
         Reinit();
+        silence_.Reset();
     }
 
     if(init_)
@@ -118,5 +120,6 @@ float Pluck::Process(float &trig)
         } while(--nn);
     }
     phs256_ = phs256;
+    silence_.Process(out);
     return out;
 }
@@ -4,6 +4,7 @@
 #define DSY_PLUCK_H
 
 #include <stdint.h>
+#include "Utility/silencedetector.h"
 #ifdef __cplusplus
 
 namespace daisysp
@@ -84,6 +85,10 @@ class Pluck
     /** Returns the current value for mode.
     */
     inline int32_t GetMode() { return mode_; }
+    /** True once the output has stayed below -80 dBFS for 50 ms.
+        Process may then be skipped until the next trigger.
+    */
+    inline bool IsSilent() const { return silence_.IsSilent(); }
 
   private:
     void    Reinit();
@@ -94,6 +99,8 @@ class Pluck
     float   sample_rate_;
     char    init_;
     int32_t mode_;
+
+    SilenceDetector silence_;
 };
 } // namespace daisysp
 #endif
@@ -1,10 +1,14 @@
 #include "resonator.h"
 #include <math.h>
+#include <cmath>
+#include "profile.h"
 
 using namespace daisysp;
 
-void Resonator::Init(float position, int resolution, float sample_rate)
+template <typename T>
+void ResonatorT<T>::Init(float position, int resolution, float sample_rate)
 {
+    DSY_PROFILE_SCOPE("Resonator::Init");
     sample_rate_ = sample_rate;
 
     SetFreq(440.f);
@@ -16,71 +20,74 @@ void Resonator::Init(float position, int resolution, float sample_rate)
 
     for(int i = 0; i < resolution; ++i)
     {
-        mode_amplitude_[i] = cos(position * TWOPI_F) * 0.25f;
+        mode_amplitude_[i] = std::cos(T(position) * T(TWOPI_F)) * T(0.25);
     }
 
-    for(int i = 0; i < kMaxNumModes / kModeBatchSize; ++i)
+    for(int i = 0; i < kNumBatches; ++i)
     {
         mode_filters_[i].Init();
     }
 }
 
-inline float NthHarmonicCompensation(int n, float stiffness)
+template <typename T>
+inline T NthHarmonicCompensation(int n, T stiffness)
 {
-    float stretch_factor = 1.0f;
+    T stretch_factor = 1;
     for(int i = 0; i < n - 1; ++i)
     {
         stretch_factor += stiffness;
-        if(stiffness < 0.0f)
+        if(stiffness < 0)
         {
-            stiffness *= 0.93f;
+            stiffness *= T(0.93);
         }
         else
         {
-            stiffness *= 0.98f;
+            stiffness *= T(0.98);
         }
     }
-    return 1.0f / stretch_factor;
+    return T(1) / stretch_factor;
 }
 
-float Resonator::Process(const float in)
+template <typename T>
+T ResonatorT<T>::Process(const T in)
 {
+    DSY_PROFILE_SCOPE("Resonator::Process");
     //convert Hz to cycles / sample
-    float out = 0.f;
+    T out = 0;
 
-    float stiffness  = CalcStiff(structure_);
-    float f0         = frequency_ * NthHarmonicCompensation(3, stiffness);
-    float brightness = brightness_;
+    T stiffness  = CalcStiff(structure_);
+    T f0         = frequency_ * NthHarmonicCompensation(3, stiffness);
+    T brightness = brightness_;
 
-    float harmonic       = f0;
-    float stretch_factor = 1.0f;
+    T harmonic       = f0;
+    T stretch_factor = 1;
 
     float input  = damping_ * 79.7f;
-    float q_sqrt = powf(2.f, input * ratiofrac_);
+    T     q_sqrt = SemitonesToRatio(input);
 
-    float q = 500.0f * q_sqrt * q_sqrt;
-    brightness *= 1.0f - structure_ * 0.3f;
-    brightness *= 1.0f - damping_ * 0.3f;
-    float q_loss = brightness * (2.0f - brightness) * 0.85f + 0.15f;
+    T q = T(500) * q_sqrt * q_sqrt;
+    brightness *= T(1) - structure_ * T(0.3);
+    brightness *= T(1) - damping_ * T(0.3);
+    T q_loss = brightness * (T(2) - brightness) * T(0.85) + T(0.15);
 
-    float mode_q[kModeBatchSize];
-    float mode_f[kModeBatchSize];
-    float mode_a[kModeBatchSize];
-    int   batch_counter = 0;
+    T   mode_q[kModeBatchSize];
+    T   mode_f[kModeBatchSize];
+    T   mode_a[kModeBatchSize];
+    int batch_counter = 0;
 
-    ResonatorSvf<kModeBatchSize>* batch_processor = &mode_filters_[0];
+    ResonatorSvf<kModeBatchSize, T>* batch_processor = &mode_filters_[0];
 
     for(int i = 0; i < resolution_; ++i)
     {
-        float mode_frequency = harmonic * stretch_factor;
-        if(mode_frequency >= 0.499f)
+        T mode_frequency = harmonic * stretch_factor;
+        if(mode_frequency >= T(0.499))
         {
-            mode_frequency = 0.499f;
+            mode_frequency = T(0.499);
         }
-        const float mode_attenuation = 1.0f - mode_frequency * 2.0f;
+        const T mode_attenuation = T(1) - mode_frequency * T(2);
 
         mode_f[batch_counter] = mode_frequency;
-        mode_q[batch_counter] = 1.0f + mode_frequency * q;
+        mode_q[batch_counter] = T(1) + mode_frequency * q;
         mode_a[batch_counter] = mode_amplitude_[i] * mode_attenuation;
         ++batch_counter;
 
@@ -88,21 +95,22 @@ float Resonator::Process(const float in)
         {
             batch_counter = 0;
             batch_processor
-                ->Process<ResonatorSvf<kModeBatchSize>::BAND_PASS, true>(
-                    mode_f, mode_q, mode_a, in, &out);
+                ->template Process<
+                    ResonatorSvf<kModeBatchSize, T>::BAND_PASS,
+                    true>(mode_f, mode_q, mode_a, in, &out);
             ++batch_processor;
         }
 
         stretch_factor += stiffness;
-        if(stiffness < 0.0f)
+        if(stiffness < 0)
         {
             // Make sure that the partials do not fold back into negative frequencies.
-            stiffness *= 0.93f;
+            stiffness *= T(0.93);
         }
         else
         {
             // This helps adding a few extra partials in the highest frequencies.
-            stiffness *= 0.98f;
+            stiffness *= T(0.98);
         }
         harmonic += f0;
         q *= q_loss;
@@ -111,48 +119,56 @@ float Resonator::Process(const float in)
     return out;
 }
 
-void Resonator::SetFreq(float freq)
+template <typename T>
+void ResonatorT<T>::SetFreq(float freq)
 {
     frequency_ = freq / sample_rate_;
 }
 
-void Resonator::SetStructure(float structure)
+template <typename T>
+void ResonatorT<T>::SetStructure(float structure)
 {
     structure_ = fmax(fmin(structure, 1.f), 0.f);
 }
 
-void Resonator::SetBrightness(float brightness)
+template <typename T>
+void ResonatorT<T>::SetBrightness(float brightness)
 {
     brightness_ = fmax(fmin(brightness, 1.f), 0.f);
 }
 
-void Resonator::SetDamping(float damping)
+template <typename T>
+void ResonatorT<T>::SetDamping(float damping)
 {
     damping_ = fmax(fmin(damping, 1.f), 0.f);
 }
 
-float Resonator::CalcStiff(float sig)
+template <typename T>
+T ResonatorT<T>::CalcStiff(T sig)
 {
-    if(sig < .25f)
+    if(sig < T(.25))
     {
-        sig = .25 - sig;
-        sig = -sig * .25;
+        sig = T(.25) - sig;
+        sig = -sig * T(.25);
     }
-    else if(sig < .3f)
+    else if(sig < T(.3))
     {
-        sig = 0.f;
+        sig = 0;
     }
-    else if(sig < .9f)
+    else if(sig < T(.9))
     {
-        sig -= .3f;
+        sig -= T(.3);
         sig *= stiff_frac_2;
     }
     else
     {
-        sig -= .9f;
+        sig -= T(.9);
         sig *= 10; // div by .1
         sig *= sig;
-        sig = 1.5 - cos(sig * PI_F) * .5f;
+        sig = T(1.5) - std::cos(sig * T(PI_F)) * T(.5);
     }
     return sig;
 }
+
+template class daisysp::ResonatorT<float>;
+template class daisysp::ResonatorT<double>;
@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "Utility/dsp.h"
+#include "Utility/denormal.h"
 #ifdef __cplusplus
 
 
@@ -22,7 +23,7 @@ namespace daisysp
        to an independent module. \n
        Original code written by Emilie Gillet in 2016. \n
 */
-template <int batch_size>
+template <int batch_size, typename T = float>
 class ResonatorSvf
 {
   public:
@@ -46,40 +47,35 @@ class ResonatorSvf
     }
 
     template <FilterMode mode, bool add>
-    void Process(const float* f,
-                 const float* q,
-                 const float* gain,
-                 const float  in,
-                 float*       out)
+    void Process(const T* f, const T* q, const T* gain, const T in, T* out)
     {
-        float g[batch_size];
-        float r[batch_size];
-        float r_plus_g[batch_size];
-        float h[batch_size];
-        float state_1[batch_size];
-        float state_2[batch_size];
-        float gains[batch_size];
+        T g[batch_size];
+        T r[batch_size];
+        T r_plus_g[batch_size];
+        T h[batch_size];
+        T state_1[batch_size];
+        T state_2[batch_size];
+        T gains[batch_size];
         for(int i = 0; i < batch_size; ++i)
         {
             g[i]        = fasttan(f[i]);
-            r[i]        = 1.0f / q[i];
-            h[i]        = 1.0f / (1.0f + r[i] * g[i] + g[i] * g[i]);
+            r[i]        = T(1) / q[i];
+            h[i]        = T(1) / (T(1) + r[i] * g[i] + g[i] * g[i]);
             r_plus_g[i] = r[i] + g[i];
             state_1[i]  = state_1_[i];
             state_2[i]  = state_2_[i];
             gains[i]    = gain[i];
         }
 
-        float s_in  = in;
-        float s_out = 0.0f;
+        T s_in  = in;
+        T s_out = 0;
         for(int i = 0; i < batch_size; ++i)
         {
-            const float hp
-                = (s_in - r_plus_g[i] * state_1[i] - state_2[i]) * h[i];
-            const float bp = g[i] * hp + state_1[i];
-            state_1[i]     = g[i] * hp + bp;
-            const float lp = g[i] * bp + state_2[i];
-            state_2[i]     = g[i] * bp + lp;
+            const T hp = (s_in - r_plus_g[i] * state_1[i] - state_2[i]) * h[i];
+            const T bp = g[i] * hp + state_1[i];
+            state_1[i] = g[i] * hp + bp;
+            const T lp = g[i] * bp + state_2[i];
+            state_2[i] = g[i] * bp + lp;
             s_out += gains[i] * ((mode == LOW_PASS) ? lp : bp);
         }
         if(add)
@@ -93,24 +89,24 @@ class ResonatorSvf
 
         for(int i = 0; i < batch_size; ++i)
         {
-            state_1_[i] = state_1[i];
-            state_2_[i] = state_2[i];
+            state_1_[i] = FlushDenormal(state_1[i]);
+            state_2_[i] = FlushDenormal(state_2[i]);
         }
     }
 
   private:
     static constexpr float kPiPow3 = PI_F * PI_F * PI_F;
     static constexpr float kPiPow5 = kPiPow3 * PI_F * PI_F;
-    static inline float    fasttan(float f)
+    static inline T        fasttan(T f)
     {
-        const float a  = 3.260e-01 * kPiPow3;
-        const float b  = 1.823e-01 * kPiPow5;
-        float       f2 = f * f;
-        return f * (PI_F + f2 * (a + b * f2));
+        const T a  = T(3.260e-01 * kPiPow3);
+        const T b  = T(1.823e-01 * kPiPow5);
+        T       f2 = f * f;
+        return f * (T(PI_F) + f2 * (a + b * f2));
     }
 
-    float state_1_[batch_size];
-    float state_2_[batch_size];
+    T state_1_[batch_size];
+    T state_2_[batch_size];
 };
 
 
@@ -121,12 +117,15 @@ class ResonatorSvf
        Ported from pichenettes/eurorack/plaits/dsp/physical_modelling/resonator.h \n
        to an independent module. \n
        Original code written by Emilie Gillet in 2016. \n 
+       The mode filters and signal path use the sample type T, float or
+       double. Resonator is the float version.
 */
-class Resonator
+template <typename T = float>
+class ResonatorT
 {
   public:
-    Resonator() {}
-    ~Resonator() {}
+    ResonatorT() {}
+    ~ResonatorT() {}
 
     /** Initialize the module
         \param position    Offset the phase of the amplitudes. 0-1
@@ -138,7 +137,7 @@ class Resonator
     /** Get the next sample_rate
         \param in The signal to excited the resonant body
     */
-    float Process(const float in);
+    T Process(const T in);
 
     /** Resonator frequency.
         \param freq Frequency in Hz.
@@ -166,18 +165,21 @@ class Resonator
 
     static constexpr int   kMaxNumModes   = 24;
     static constexpr int   kModeBatchSize = 4;
-    static constexpr float ratiofrac_     = 1.f / 12.f;
     static constexpr float stiff_frac_    = 1.f / 64.f;
     static constexpr float stiff_frac_2   = 1.f / .6f;
 
     float sample_rate_;
 
-    float CalcStiff(float sig);
+    T CalcStiff(T sig);
 
-    float                        mode_amplitude_[kMaxNumModes];
-    ResonatorSvf<kModeBatchSize> mode_filters_[kMaxNumModes / kModeBatchSize];
+    static constexpr int kNumBatches = kMaxNumModes / kModeBatchSize;
+
+    T                               mode_amplitude_[kMaxNumModes];
+    ResonatorSvf<kModeBatchSize, T> mode_filters_[kNumBatches];
 };
 
+using Resonator = ResonatorT<float>;
+
 } // namespace daisysp
 #endif
 #endif
@@ -4,13 +4,31 @@
 
 using namespace daisysp;
 
+#ifndef DSY_NO_EMBEDDED_BUFFERS
 void StringVoice::Init(float sample_rate)
+{
+    string_.Init(sample_rate);
+    InitParams(sample_rate);
+}
+#endif
+
+bool StringVoice::Init(float sample_rate, Allocator &allocator)
+{
+    if(!string_.Init(sample_rate, allocator))
+    {
+        return false;
+    }
+    InitParams(sample_rate);
+    return true;
+}
+
+void StringVoice::InitParams(float sample_rate)
 {
     sample_rate_ = sample_rate;
 
     excitation_filter_.Init(sample_rate);
-    string_.Init(sample_rate_);
     dust_.Init();
+    silence_.Init(sample_rate);
     remaining_noise_samples_ = 0;
 
     SetSustain(false);
@@ -34,6 +52,7 @@ void StringVoice::SetSustain(bool sustain)
 void StringVoice::Trig()
 {
     trig_ = true;
+    silence_.Reset();
 }
 
 void StringVoice::SetFreq(float freq)
@@ -87,14 +106,14 @@ float StringVoice::Process(bool trigger)
         const float f      = 4.0f * f0_;
         const float cutoff = fmin(
             f
-                * powf(2.f,
-                       kOneTwelfth * (brightness * (2.0f - brightness) - 0.5f)
-                           * range),
+                * SemitonesToRatio((brightness * (2.0f - brightness) - 0.5f)
+                                   * range),
             0.499f);
         const float q            = sustain_ ? 1.0f : 0.5f;
         remaining_noise_samples_ = static_cast<size_t>(1.0f / f0_);
         excitation_filter_.SetFreq(cutoff * sample_rate_);
         excitation_filter_.SetRes(q);
+        silence_.Reset();
     }
 
     float temp = 0.f;
@@ -120,5 +139,7 @@ float StringVoice::Process(bool trigger)
     string_.SetBrightness(brightness);
     string_.SetDamping(damping);
 
-    return string_.Process(temp);
+    const float out = string_.Process(temp);
+    silence_.Process(out);
+    return out;
 }
@@ -5,6 +5,7 @@
 #include "Filters/svf.h"
 #include "PhysicalModeling/KarplusString.h"
 #include "Noise/dust.h"
+#include "Utility/silencedetector.h"
 #include <stdint.h>
 #ifdef __cplusplus
 
@@ -27,10 +28,25 @@ class StringVoice
     StringVoice() {}
     ~StringVoice() {}
 
+#ifndef DSY_NO_EMBEDDED_BUFFERS
     /** Initialize the module
         \param sample_rate Audio engine sample rate
     */
     void Init(float sample_rate);
+#endif
+
+    /** Initialize the module, taking the string's delay memory from allocator
+        \param sample_rate Audio engine sample rate
+        \param allocator Source of the delay memory
+        \return false if the allocator is exhausted
+    */
+    bool Init(float sample_rate, Allocator &allocator);
+
+    /** Bytes Init takes from an Allocator at sample_rate */
+    static size_t GetRequiredMemory(float sample_rate)
+    {
+        return String::GetRequiredMemory(sample_rate);
+    }
 
     /** Reset the string oscillator */
     void Reset();
@@ -76,6 +92,11 @@ class StringVoice
     /** Get the raw excitation signal. Must call Process() first. */
     float GetAux();
 
+    /** True once the output has stayed below -80 dBFS for 50 ms without
+        sustain. Process may then be skipped until the next trigger.
+    */
+    bool IsSilent() const { return !sustain_ && silence_.IsSilent(); }
+
   private:
     float sample_rate_;
 
@@ -88,6 +109,10 @@ class StringVoice
     Svf    excitation_filter_;
     String string_;
     size_t remaining_noise_samples_;
+
+    SilenceDetector silence_;
+
+    void InitParams(float sample_rate);
 };
 } // namespace daisysp
 #endif
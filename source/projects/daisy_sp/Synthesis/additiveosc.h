@@ -0,0 +1,318 @@
+#pragma once
+#ifndef DSY_ADDITIVEOSC_H
+#define DSY_ADDITIVEOSC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include "Utility/dsp.h"
+#ifdef __cplusplus
+
+/** @file additiveosc.h */
+
+namespace daisysp
+{
+/**
+       @brief Additive oscillator for large numbers of harmonic partials
+       @date Oct 2026
+       Renders num_partials sine partials at integer multiples of the
+       fundamental, for additive synthesis and resynthesis where
+       HarmonicOscillator runs out of harmonics and one Oscillator per
+       partial costs too much. \n
+       Each partial is a rotating phasor, two multiply-adds per sample and
+       no sinf. Partials are stored as structure-of-arrays and processed in
+       groups of kLanes, so the partial loop vectorizes. \n
+       Rounding makes the phasors drift slowly, so a group of partials is
+       re-seeded from an exact double precision phase every kReseedInterval
+       samples, round robin. With 512 partials every partial is refreshed
+       about every 2048 samples, and the drift stays below -80 dB. \n
+       Amplitude changes are smoothed per partial. Amplitudes taper to zero
+       towards Nyquist as in HarmonicOscillator, and silent partials at the
+       top of the spectrum are not rendered at all, so low notes with a
+       bright spectrum cost the most. \n
+       num_partials must be a multiple of kLanes.
+*/
+template <size_t num_partials = 256>
+class AdditiveOscillator
+{
+  public:
+    AdditiveOscillator() {}
+    ~AdditiveOscillator() {}
+
+    static constexpr size_t kLanes          = 8;
+    static constexpr size_t kReseedInterval = 32;
+
+    static_assert(num_partials > 0 && num_partials % kLanes == 0,
+                  "num_partials must be a multiple of kLanes");
+
+    /** Initializes the oscillator
+        \param sample_rate Audio engine sample rate
+
+        Defaults:
+        - 440 Hz, first harmonic index 1
+        - only the fundamental, at amplitude 1.0
+        - 5 ms amplitude smoothing
+    */
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+        phase_       = 0.0;
+        frequency_   = 0.0f;
+        first_harmonic_index_ = 1;
+        for(size_t i = 0; i < num_partials; i++)
+        {
+            cos_[i]       = 1.0f;
+            sin_[i]       = 0.0f;
+            amplitude_[i] = 0.0f;
+            target_[i]    = 0.0f;
+            newamplitude_[i] = 0.0f;
+        }
+        newamplitude_[0] = 1.0f;
+        active_          = 0;
+        reseed_next_     = 0;
+        reseed_count_    = 0;
+        smooth_size_     = 0;
+        SetSmoothTime(0.005f);
+        SetFreq(440.0f);
+        recalc_ = true;
+    }
+
+    /** Get the next floating point sample */
+    float Process()
+    {
+        float out;
+        ProcessBlock(&out, 1);
+        return out;
+    }
+
+    /** Renders a block
+        \param out size samples
+        \param size number of samples
+    */
+    void ProcessBlock(float *out, size_t size)
+    {
+        if(recalc_)
+        {
+            Recalc();
+        }
+        if(size != smooth_size_)
+        {
+            smooth_size_  = size;
+            smooth_coeff_ = 1.0f - expf(-(float)size / smooth_samples_);
+        }
+
+        // per partial linear ramp towards the end of block amplitude
+        const float inv_size = 1.0f / size;
+        for(size_t i = 0; i < num_partials; i++)
+        {
+            float end = amplitude_[i]
+                        + smooth_coeff_ * (target_[i] - amplitude_[i]);
+            end       = fabsf(target_[i] - end) < 1e-6f ? target_[i] : end;
+            delta_[i] = (end - amplitude_[i]) * inv_size;
+            end_[i]   = end;
+        }
+        UpdateActive();
+
+        float acc[kLanes];
+        for(size_t n = 0; n < size; n++)
+        {
+            for(size_t l = 0; l < kLanes; l++)
+            {
+                acc[l] = 0.0f;
+            }
+            for(size_t g = 0; g < active_; g += kLanes)
+            {
+                float       *c  = cos_ + g;
+                float       *s  = sin_ + g;
+                float       *a  = amplitude_ + g;
+                const float *cw = rot_cos_ + g;
+                const float *sw = rot_sin_ + g;
+                const float *da = delta_ + g;
+                for(size_t l = 0; l < kLanes; l++)
+                {
+                    const float nc = c[l] * cw[l] - s[l] * sw[l];
+                    const float ns = s[l] * cw[l] + c[l] * sw[l];
+                    c[l]           = nc;
+                    s[l]           = ns;
+                    acc[l] += a[l] * ns;
+                    a[l] += da[l];
+                }
+            }
+            out[n] = SumLanes(acc);
+        }
+
+        for(size_t i = 0; i < num_partials; i++)
+        {
+            amplitude_[i] = end_[i];
+        }
+
+        phase_ += (double)frequency_ * size;
+        phase_ -= floor(phase_);
+
+        reseed_count_ += size;
+        while(reseed_count_ >= kReseedInterval)
+        {
+            reseed_count_ -= kReseedInterval;
+            if(reseed_next_ >= active_)
+            {
+                reseed_next_ = 0;
+            }
+            Reseed(reseed_next_, reseed_next_ + kLanes);
+            reseed_next_ += kLanes;
+        }
+    }
+
+    /** Set the main frequency
+        \param freq Freq to be set in Hz, 0 to Nyquist
+    */
+    void SetFreq(float freq)
+    {
+        freq       = fclamp(freq / sample_rate_, 0.0f, 0.5f);
+        recalc_    = cmp(freq, frequency_) || recalc_;
+        frequency_ = freq;
+    }
+
+    /** Offset the set of harmonics. Passing in 3 means "harmonic 0" is the 3rd harm., 1 is the 4th, etc.
+        \param idx Default behavior is 1. Values < 0 default to 1.
+    */
+    void SetFirstHarmIdx(int idx)
+    {
+        idx = idx < 1 ? 1 : idx;
+        if(idx != first_harmonic_index_)
+        {
+            first_harmonic_index_ = idx;
+            recalc_               = true;
+            Reseed(0, num_partials);
+        }
+    }
+
+    /** Set the amplitudes of each partial.
+        \param amplitudes Amplitudes to set. Sum of all amplitudes must be < 1. The array referenced must be at least as large as num_partials.
+    */
+    void SetAmplitudes(const float *amplitudes)
+    {
+        for(size_t i = 0; i < num_partials; i++)
+        {
+            newamplitude_[i] = amplitudes[i];
+        }
+        recalc_ = true;
+    }
+
+    /** Sets one amplitude. Does nothing if idx out of range.
+        \param amp Amplitude to set
+        \param idx Which partial to set.
+    */
+    void SetSingleAmp(const float amp, int idx)
+    {
+        if(idx < 0 || idx >= (int)num_partials)
+        {
+            return;
+        }
+        newamplitude_[idx] = amp;
+        recalc_            = true;
+    }
+
+    /** Sets how fast amplitude changes are followed
+        \param time time constant in seconds, 0 jumps at the next block
+    */
+    void SetSmoothTime(float time)
+    {
+        smooth_samples_ = fmax(time * sample_rate_, 1e-3f);
+        smooth_size_    = 0;
+    }
+
+    /** Returns the number of partials rendered in the last block */
+    size_t GetNumActive() const { return active_; }
+
+  private:
+    bool cmp(float a, float b) { return fabsf(a - b) > .000001f; }
+
+    // per partial rotation and Nyquist tapered target amplitude
+    void Recalc()
+    {
+        recalc_ = false;
+
+        // cos and sin of k * w by complex multiplication, in double so the
+        // error does not build up over the partials
+        const double w  = TWOPI_F * (double)frequency_;
+        const double cw = cos(w), sw = sin(w);
+        double c = cos(w * first_harmonic_index_);
+        double s = sin(w * first_harmonic_index_);
+        for(size_t i = 0; i < num_partials; i++)
+        {
+            rot_cos_[i]    = (float)c;
+            rot_sin_[i]    = (float)s;
+            const double t = c * cw - s * sw;
+            s              = s * cw + c * sw;
+            c              = t;
+
+            float f = frequency_ * (float)(first_harmonic_index_ + i);
+            f       = f >= 0.5f ? 0.5f : f;
+            target_[i] = newamplitude_[i] * (1.0f - f * 2.0f);
+        }
+    }
+
+    // render only up to the highest partial that is or will be audible,
+    // partials coming back into range start from their exact phase
+    void UpdateActive()
+    {
+        size_t top = num_partials;
+        while(top > 0 && target_[top - 1] == 0.0f
+              && amplitude_[top - 1] == 0.0f)
+        {
+            top--;
+        }
+        top = (top + kLanes - 1) / kLanes * kLanes;
+        if(top > active_)
+        {
+            Reseed(active_, top);
+        }
+        active_ = top;
+    }
+
+    // exact phasors for partials [begin, end) from the master phase
+    void Reseed(size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end && i < num_partials; i++)
+        {
+            double p = phase_ * (double)(first_harmonic_index_ + i);
+            p -= floor(p);
+            cos_[i] = cosf((float)p * TWOPI_F);
+            sin_[i] = sinf((float)p * TWOPI_F);
+        }
+    }
+
+    // pairwise sum, written out so it vectorizes
+    static float SumLanes(float *x)
+    {
+        for(size_t n = kLanes / 2; n > 0; n /= 2)
+        {
+            for(size_t i = 0; i < n; i++)
+            {
+                x[i] += x[i + n];
+            }
+        }
+        return x[0];
+    }
+
+    float  sample_rate_;
+    double phase_; // master phase, 0 to 1
+    float  frequency_;
+    int    first_harmonic_index_;
+    bool   recalc_;
+
+    float  smooth_samples_, smooth_coeff_;
+    size_t smooth_size_;
+    size_t active_, reseed_next_, reseed_count_;
+
+    // per partial lanes
+    float cos_[num_partials], sin_[num_partials];
+    float rot_cos_[num_partials], rot_sin_[num_partials];
+    float amplitude_[num_partials], delta_[num_partials], end_[num_partials];
+    float target_[num_partials];
+    float newamplitude_[num_partials];
+};
+
+} // namespace daisysp
+#endif
+#endif
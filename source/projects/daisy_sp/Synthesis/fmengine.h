@@ -0,0 +1,495 @@
+#pragma once
+#ifndef DSY_FMENGINE_H
+#define DSY_FMENGINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include "Utility/dsp.h"
+#ifdef __cplusplus
+
+/** @file fmengine.h */
+
+namespace daisysp
+{
+/**
+       @brief 4 or 6 operator FM synth with algorithms and operator envelopes
+       @date Oct 2026
+       Extends Fm2 to num_ops phase modulated sine operators, routed by one
+       of kNumAlgorithms algorithms, each with its own ratio, level and
+       ADSR envelope. One operator per algorithm has self feedback. \n
+       num_voices voices play the same patch. Each operator is evaluated
+       for all voices at once, with voices in SIMD lanes, so a polyphonic
+       patch costs far less than a voice per instance. Set num_voices to 1
+       for a monophonic engine. \n
+       Operators and feedback read a shared interpolated sine table instead
+       of calling sinf. Envelopes run at control rate, every kChunkSize
+       samples, and are ramped linearly in between. \n
+       Operators are numbered from 0. Modulators always have a higher
+       number than the operators they modulate, as on the DX7 with its
+       numbering reversed.
+*/
+template <size_t num_ops, size_t num_voices = 1>
+class FmEngine
+{
+    static_assert(num_ops == 4 || num_ops == 6,
+                  "FmEngine supports 4 or 6 operators");
+    static_assert(num_voices > 0, "FmEngine needs at least one voice");
+
+  public:
+    FmEngine() {}
+    ~FmEngine() {}
+
+    static constexpr size_t kNumAlgorithms = 8;
+    static constexpr size_t kChunkSize     = 16;
+
+    /** Initializes the engine
+        \param sample_rate Audio engine sample rate
+
+        Defaults:
+        - algorithm 0, a single stack
+        - all ratios 1.0, all levels 1.0, feedback 0
+        - envelopes 5 ms attack, 200 ms decay, 0.7 sustain, 300 ms release
+    */
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+        for(size_t i = 0; i <= kSineSize + 1; i++)
+        {
+            sine_[i] = sinf(TWOPI_F * i / kSineSize);
+        }
+        for(size_t op = 0; op < num_ops; op++)
+        {
+            ratio_[op] = 1.0f;
+            level_[op] = 1.0f;
+            SetEnvelope(op, 0.005f, 0.2f, 0.7f, 0.3f);
+            for(size_t v = 0; v < num_voices; v++)
+            {
+                phase_[op][v] = 0.0f;
+                inc_[op][v]   = 0.0f;
+                out_[op][v]   = 0.0f;
+                env_[op][v]   = 0.0f;
+                gain_[op][v]  = 0.0f;
+                target_[op][v] = 0.0f;
+                stage_[op][v] = IDLE;
+            }
+        }
+        for(size_t v = 0; v < num_voices; v++)
+        {
+            freq_[v]     = 0.0f;
+            velocity_[v] = 0.0f;
+            fb_[0][v] = fb_[1][v] = 0.0f;
+        }
+        feedback_ = 0.0f;
+        SetAlgorithm(0);
+    }
+
+    /** Renders the sum of all voices
+        \param out size samples
+        \param size number of samples
+    */
+    void ProcessBlock(float *out, size_t size)
+    {
+        for(size_t n = 0; n < size; n += kChunkSize)
+        {
+            const size_t chunk = size - n < kChunkSize ? size - n : kChunkSize;
+            if(UpdateEnvelopes(chunk))
+            {
+                RenderChunk(out + n, chunk);
+            }
+            else
+            {
+                for(size_t i = 0; i < chunk; i++)
+                {
+                    out[n + i] = 0.0f;
+                }
+            }
+        }
+    }
+
+    /** Get the next floating point sample */
+    float Process()
+    {
+        float out;
+        ProcessBlock(&out, 1);
+        return out;
+    }
+
+    /** Starts a note, restarting the operator phases and envelopes
+        \param voice 0 to num_voices - 1
+        \param freq frequency in Hz
+        \param velocity 0.0 to 1.0, scales every operator
+    */
+    void NoteOn(size_t voice, float freq, float velocity = 1.0f)
+    {
+        if(voice >= num_voices)
+        {
+            return;
+        }
+        velocity_[voice] = fclamp(velocity, 0.0f, 1.0f);
+        fb_[0][voice] = fb_[1][voice] = 0.0f;
+        for(size_t op = 0; op < num_ops; op++)
+        {
+            phase_[op][voice] = 0.0f;
+            stage_[op][voice] = ATTACK;
+        }
+        SetFreq(voice, freq);
+    }
+
+    /** Releases a note */
+    void NoteOff(size_t voice)
+    {
+        if(voice >= num_voices)
+        {
+            return;
+        }
+        for(size_t op = 0; op < num_ops; op++)
+        {
+            stage_[op][voice] = stage_[op][voice] == IDLE ? IDLE : RELEASE;
+        }
+    }
+
+    /** Changes the frequency of a voice without retriggering it */
+    void SetFreq(size_t voice, float freq)
+    {
+        if(voice >= num_voices)
+        {
+            return;
+        }
+        freq_[voice] = fabsf(freq) / sample_rate_;
+        for(size_t op = 0; op < num_ops; op++)
+        {
+            inc_[op][voice] = fmin(freq_[voice] * ratio_[op], 0.5f);
+        }
+    }
+
+    /** Returns true while any envelope of the voice is running */
+    bool IsActive(size_t voice) const
+    {
+        for(size_t op = 0; op < num_ops; op++)
+        {
+            if(voice < num_voices && stage_[op][voice] != IDLE)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Selects the operator routing
+        \param algorithm 0 to kNumAlgorithms - 1. With 4 operators these
+               are TX81Z algorithms 1 to 8. With 6 operators, 0 is a single
+               stack and 1 to 7 are DX7 algorithms 1, 5, 7, 16, 22, 31
+               and 32.
+    */
+    void SetAlgorithm(size_t algorithm)
+    {
+        const Algorithm &a = GetAlgorithms()[algorithm < kNumAlgorithms
+                                                 ? algorithm
+                                                 : kNumAlgorithms - 1];
+        num_carriers_      = 0;
+        for(size_t op = 0; op < num_ops; op++)
+        {
+            num_mods_[op] = 0;
+            for(size_t m = op + 1; m < num_ops; m++)
+            {
+                if(a.mods[op] & (1 << m))
+                {
+                    mods_[op][num_mods_[op]++] = m;
+                }
+            }
+            if(a.carriers & (1 << op))
+            {
+                carriers_[num_carriers_++] = op;
+            }
+        }
+        carrier_gain_ = 1.0f / num_carriers_;
+    }
+
+    /** Sets an operator frequency relative to the note */
+    void SetRatio(size_t op, float ratio)
+    {
+        if(op >= num_ops)
+        {
+            return;
+        }
+        ratio_[op] = fabsf(ratio);
+        for(size_t v = 0; v < num_voices; v++)
+        {
+            inc_[op][v] = fmin(freq_[v] * ratio_[op], 0.5f);
+        }
+    }
+
+    /** Sets an operator output level
+        \param level 0.0 to 1.0. On a modulator 1.0 is a peak phase
+               deviation of 2 cycles.
+    */
+    void SetLevel(size_t op, float level)
+    {
+        if(op < num_ops)
+        {
+            level_[op] = fclamp(level, 0.0f, 1.0f);
+        }
+    }
+
+    /** Sets an operator envelope
+        \param attack linear rise time in seconds
+        \param decay time constant in seconds of the fall to sustain
+        \param sustain level 0.0 to 1.0
+        \param release time constant in seconds of the fall to silence
+    */
+    void SetEnvelope(size_t op,
+                     float  attack,
+                     float  decay,
+                     float  sustain,
+                     float  release)
+    {
+        if(op >= num_ops)
+        {
+            return;
+        }
+        attack_[op]  = 1.0f / fmax(attack * sample_rate_, 1.0f);
+        decay_[op]   = 1.0f / fmax(decay * sample_rate_, 1.0f);
+        sustain_[op] = fclamp(sustain, 0.0f, 1.0f);
+        release_[op] = 1.0f / fmax(release * sample_rate_, 1.0f);
+        decay_chunk_[op]   = expf(-decay_[op] * kChunkSize);
+        release_chunk_[op] = expf(-release_[op] * kChunkSize);
+    }
+
+    /** Sets the self feedback of the feedback operator, 0.0 to 1.0 */
+    void SetFeedback(float feedback)
+    {
+        feedback_ = fclamp(feedback, 0.0f, 1.0f) * kMaxFeedback;
+    }
+
+  private:
+    static constexpr size_t kSineSize    = 1024;
+    static constexpr float  kModDepth    = 2.0f;  // cycles at level 1
+    static constexpr float  kMaxFeedback = 0.25f; // cycles
+    static constexpr float  kIdleLevel   = 1e-4f; // -80 dB
+
+    enum Stage : uint8_t
+    {
+        IDLE,
+        ATTACK,
+        DECAY,
+        SUSTAIN,
+        RELEASE,
+    };
+
+    // mods: bit m set if operator m modulates the operator,
+    // carriers: bit set for each operator heard at the output
+    struct Algorithm
+    {
+        uint8_t mods[6];
+        uint8_t carriers;
+    };
+
+    static const Algorithm *GetAlgorithms()
+    {
+        // TX81Z algorithms 1-8, operator 3 has feedback
+        static const Algorithm kAlgorithms4[kNumAlgorithms] = {
+            {{0x02, 0x04, 0x08}, 0x01},
+            {{0x02, 0x0c, 0x00}, 0x01},
+            {{0x0a, 0x04, 0x00}, 0x01},
+            {{0x06, 0x00, 0x08}, 0x01},
+            {{0x02, 0x00, 0x08}, 0x05},
+            {{0x08, 0x08, 0x08}, 0x07},
+            {{0x00, 0x00, 0x08}, 0x07},
+            {{0x00, 0x00, 0x00}, 0x0f},
+        };
+        // a six operator stack, then DX7 algorithms 1, 5, 7, 16, 22, 31
+        // and 32, operator 5 has feedback
+        static const Algorithm kAlgorithms6[kNumAlgorithms] = {
+            {{0x02, 0x04, 0x08, 0x10, 0x20}, 0x01},
+            {{0x02, 0x00, 0x08, 0x10, 0x20}, 0x05},
+            {{0x02, 0x00, 0x08, 0x00, 0x20}, 0x15},
+            {{0x02, 0x00, 0x18, 0x00, 0x20}, 0x05},
+            {{0x16, 0x00, 0x08, 0x00, 0x20}, 0x01},
+            {{0x02, 0x00, 0x20, 0x20, 0x20}, 0x1d},
+            {{0x00, 0x00, 0x00, 0x00, 0x20}, 0x1f},
+            {{0x00, 0x00, 0x00, 0x00, 0x00}, 0x3f},
+        };
+        return num_ops == 4 ? kAlgorithms4 : kAlgorithms6;
+    }
+
+    // advances the envelopes by size samples and sets each operator's gain
+    // ramp for the chunk, returns false if every voice is idle
+    bool UpdateEnvelopes(size_t size)
+    {
+        bool active = false;
+        for(size_t op = 0; op < num_ops; op++)
+        {
+            const bool  full = size == kChunkSize;
+            const float decay
+                = full ? decay_chunk_[op] : expf(-decay_[op] * size);
+            const float release
+                = full ? release_chunk_[op] : expf(-release_[op] * size);
+            for(size_t v = 0; v < num_voices; v++)
+            {
+                float e = env_[op][v];
+                switch(stage_[op][v])
+                {
+                    case ATTACK:
+                        e += attack_[op] * size;
+                        if(e >= 1.0f)
+                        {
+                            e             = 1.0f;
+                            stage_[op][v] = DECAY;
+                        }
+                        break;
+                    case DECAY:
+                        e = sustain_[op] + (e - sustain_[op]) * decay;
+                        if(e - sustain_[op] < kIdleLevel)
+                        {
+                            e             = sustain_[op];
+                            stage_[op][v] = SUSTAIN;
+                        }
+                        break;
+                    case SUSTAIN: e = sustain_[op]; break;
+                    case RELEASE:
+                        e *= release;
+                        if(e < kIdleLevel)
+                        {
+                            e             = 0.0f;
+                            stage_[op][v] = IDLE;
+                        }
+                        break;
+                    default: e = 0.0f; break;
+                }
+                env_[op][v] = e;
+
+                // ramp from exactly where the last chunk was heading, so a
+                // released voice ends at 0.0
+                const float start = target_[op][v];
+                const float end   = e * level_[op] * velocity_[v];
+                gain_[op][v]      = start;
+                gain_inc_[op][v]  = (end - start) / size;
+                target_[op][v]    = end;
+                active = active || start != 0.0f || end != 0.0f;
+            }
+        }
+        return active;
+    }
+
+    void RenderChunk(float *out, size_t size)
+    {
+        float   in[num_voices], acc[num_voices];
+        float   frac[num_voices], a[num_voices], b[num_voices];
+        int32_t index[num_voices];
+        for(size_t n = 0; n < size; n++)
+        {
+            for(size_t op = num_ops; op-- > 0;)
+            {
+                // phase modulation input, in cycles
+                for(size_t v = 0; v < num_voices; v++)
+                {
+                    in[v] = 0.0f;
+                }
+                for(size_t i = 0; i < num_mods_[op]; i++)
+                {
+                    const float *m = out_[mods_[op][i]];
+                    for(size_t v = 0; v < num_voices; v++)
+                    {
+                        in[v] += m[v] * kModDepth;
+                    }
+                }
+                if(op == num_ops - 1)
+                {
+                    // DX7 style, the mean of the last two outputs
+                    for(size_t v = 0; v < num_voices; v++)
+                    {
+                        in[v] += (fb_[0][v] + fb_[1][v]) * 0.5f * feedback_;
+                    }
+                }
+
+                // three passes, so the phase and gain arithmetic vectorizes
+                // around the table reads
+                float *phase = phase_[op];
+                float *o     = out_[op];
+                float *g     = gain_[op];
+                for(size_t v = 0; v < num_voices; v++)
+                {
+                    float p = phase[v] + in[v];
+                    p -= (float)(int32_t)p;
+                    p += (float)(int32_t)(p < 0.0f); // truncation rounds up
+                    const float x = p * kSineSize;
+                    index[v]      = (int32_t)x;
+                    frac[v]       = x - index[v];
+
+                    const float next = phase[v] + inc_[op][v];
+                    phase[v]         = next - (float)(int32_t)next;
+                }
+                for(size_t v = 0; v < num_voices; v++)
+                {
+                    a[v] = sine_[index[v]];
+                    b[v] = sine_[index[v] + 1];
+                }
+                for(size_t v = 0; v < num_voices; v++)
+                {
+                    o[v] = (a[v] + (b[v] - a[v]) * frac[v]) * g[v];
+                    g[v] += gain_inc_[op][v];
+                }
+                if(op == num_ops - 1)
+                {
+                    for(size_t v = 0; v < num_voices; v++)
+                    {
+                        fb_[1][v] = fb_[0][v];
+                        fb_[0][v] = o[v];
+                    }
+                }
+            }
+
+            for(size_t v = 0; v < num_voices; v++)
+            {
+                acc[v] = 0.0f;
+            }
+            for(size_t i = 0; i < num_carriers_; i++)
+            {
+                const float *c = out_[carriers_[i]];
+                for(size_t v = 0; v < num_voices; v++)
+                {
+                    acc[v] += c[v];
+                }
+            }
+            out[n] = SumVoices(acc) * carrier_gain_;
+        }
+    }
+
+    static float SumVoices(float *x)
+    {
+        float sum = 0.0f;
+        for(size_t v = 0; v < num_voices; v++)
+        {
+            sum += x[v];
+        }
+        return sum;
+    }
+
+    float sample_rate_;
+    float sine_[kSineSize + 2]; // guard points for p rounding to 1.0
+
+    // patch
+    float  ratio_[num_ops], level_[num_ops];
+    float  attack_[num_ops], decay_[num_ops], sustain_[num_ops];
+    float  release_[num_ops];
+    float  decay_chunk_[num_ops], release_chunk_[num_ops]; // per kChunkSize
+    float  feedback_;
+    size_t mods_[num_ops][num_ops], num_mods_[num_ops];
+    size_t carriers_[num_ops], num_carriers_;
+    float  carrier_gain_;
+
+    // per voice lanes, by operator
+    float   freq_[num_voices], velocity_[num_voices];
+    float   phase_[num_ops][num_voices], inc_[num_ops][num_voices];
+    float   out_[num_ops][num_voices];
+    float   env_[num_ops][num_voices];
+    float   gain_[num_ops][num_voices], gain_inc_[num_ops][num_voices];
+    float   target_[num_ops][num_voices];
+    uint8_t stage_[num_ops][num_voices];
+    float   fb_[2][num_voices];
+};
+
+} // namespace daisysp
+#endif
+#endif
@@ -0,0 +1,223 @@
+#pragma once
+#ifndef DSY_MULTIOSCILLATOR_H
+#define DSY_MULTIOSCILLATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Utility/dsp.h"
+#include "Synthesis/oscillator.h"
+#ifdef __cplusplus
+
+/** @file multioscillator.h */
+
+namespace daisysp
+{
+/**
+       @brief Bank of independent Oscillators stored structure-of-arrays
+       @date Oct 2026
+       Each channel has its own frequency, amplitude, pulse width and phase,
+       while the waveform is shared by the whole bank. \n
+       All per-channel state lives in parallel arrays and the inner loop
+       runs across channels, so the compiler advances several channels
+       per SIMD instruction. The sine is a polynomial (fastsin2pi) rather
+       than sinf for the same reason. \n
+       Waveforms use the Oscillator::WAVE_* values.
+*/
+template <size_t max_channels>
+class MultiOscillator
+{
+  public:
+    MultiOscillator() {}
+    ~MultiOscillator() {}
+
+    /** Initializes all channels
+        \param sample_rate Audio engine sample rate
+
+        Defaults:
+        - freq = 100 Hz
+        - amp = 0.5
+        - pw = 0.5
+        - waveform = sine wave
+        - channels = max_channels
+    */
+    void Init(float sample_rate)
+    {
+        sr_recip_     = 1.0f / sample_rate;
+        waveform_     = Oscillator::WAVE_SIN;
+        num_channels_ = max_channels;
+        for(size_t i = 0; i < max_channels; i++)
+        {
+            phase_[i]    = 0.0f;
+            amp_[i]      = 0.5f;
+            pw_[i]       = 0.5f;
+            last_out_[i] = 0.0f;
+            SetFreq(i, 100.0f);
+        }
+    }
+
+    /** Sets the number of channels rendered by ProcessBlock
+        \param num Clamped to max_channels
+    */
+    inline void SetNumChannels(size_t num)
+    {
+        num_channels_ = num < max_channels ? num : max_channels;
+    }
+
+    /** Returns the number of channels rendered by ProcessBlock */
+    inline size_t GetNumChannels() const { return num_channels_; }
+
+    /** Sets the frequency of one channel in Hz */
+    inline void SetFreq(size_t ch, float f)
+    {
+        phase_inc_[ch] = fclamp(f * sr_recip_, 0.0f, 0.5f);
+        // polyblep divides by the increment, keep it away from zero
+        inc_recip_[ch] = 1.0f / fmax(phase_inc_[ch], 1.0e-9f);
+    }
+
+    /** Sets the amplitude of one channel */
+    inline void SetAmp(size_t ch, float a) { amp_[ch] = a; }
+
+    /** Sets the pulse width of one channel, range 0 - 1 */
+    inline void SetPw(size_t ch, float pw) { pw_[ch] = fclamp(pw, 0.0f, 1.0f); }
+
+    /** Adds 0.0-1.0 to the phase of one channel */
+    inline void PhaseAdd(size_t ch, float phase)
+    {
+        phase_[ch] += phase;
+        phase_[ch] -= floorf(phase_[ch]);
+    }
+
+    /** Resets the phase of every channel */
+    inline void Reset(float phase = 0.0f)
+    {
+        for(size_t i = 0; i < max_channels; i++)
+        {
+            phase_[i]    = phase;
+            last_out_[i] = 0.0f;
+        }
+    }
+
+    /** Sets the waveform of the whole bank, one of Oscillator::WAVE_* */
+    inline void SetWaveform(const uint8_t wf)
+    {
+        waveform_
+            = wf < Oscillator::WAVE_LAST ? wf : (uint8_t)Oscillator::WAVE_SIN;
+    }
+
+    /** Renders a block for every active channel.
+        \param out one buffer of size samples per channel
+        \param size number of samples
+    */
+    void ProcessBlock(float **out, size_t size)
+    {
+        switch(waveform_)
+        {
+            case Oscillator::WAVE_SIN:
+                Render<Oscillator::WAVE_SIN>(out, size);
+                break;
+            case Oscillator::WAVE_TRI:
+                Render<Oscillator::WAVE_TRI>(out, size);
+                break;
+            case Oscillator::WAVE_SAW:
+                Render<Oscillator::WAVE_SAW>(out, size);
+                break;
+            case Oscillator::WAVE_RAMP:
+                Render<Oscillator::WAVE_RAMP>(out, size);
+                break;
+            case Oscillator::WAVE_SQUARE:
+                Render<Oscillator::WAVE_SQUARE>(out, size);
+                break;
+            case Oscillator::WAVE_POLYBLEP_TRI:
+                Render<Oscillator::WAVE_POLYBLEP_TRI>(out, size);
+                break;
+            case Oscillator::WAVE_POLYBLEP_SAW:
+                Render<Oscillator::WAVE_POLYBLEP_SAW>(out, size);
+                break;
+            case Oscillator::WAVE_POLYBLEP_SQUARE:
+            default: Render<Oscillator::WAVE_POLYBLEP_SQUARE>(out, size); break;
+        }
+    }
+
+  private:
+    template <uint8_t wf>
+    void Render(float **out, size_t size)
+    {
+        const size_t nch = num_channels_;
+        float        y[max_channels];
+        for(size_t i = 0; i < size; i++)
+        {
+            // lanes loop: no branches, vectorized across channels
+            for(size_t ch = 0; ch < nch; ch++)
+            {
+                y[ch] = Wave<wf>(ch) * amp_[ch];
+                float p = phase_[ch] + phase_inc_[ch];
+                phase_[ch] = p >= 1.0f ? p - 1.0f : p;
+            }
+            for(size_t ch = 0; ch < nch; ch++)
+            {
+                out[ch][i] = y[ch];
+            }
+        }
+    }
+
+    template <uint8_t wf>
+    inline float Wave(size_t ch)
+    {
+        const float p = phase_[ch];
+        float       t, o;
+        switch(wf)
+        {
+            case Oscillator::WAVE_SIN: return fastsin2pi(p);
+            case Oscillator::WAVE_TRI:
+                t = -1.0f + (2.0f * p);
+                return 2.0f * (fabsf(t) - 0.5f);
+            case Oscillator::WAVE_SAW: return 1.0f - 2.0f * p;
+            case Oscillator::WAVE_RAMP: return 2.0f * p - 1.0f;
+            case Oscillator::WAVE_SQUARE: return p < pw_[ch] ? 1.0f : -1.0f;
+            case Oscillator::WAVE_POLYBLEP_TRI:
+                t = p + 0.5f;
+                t = t >= 1.0f ? t - 1.0f : t;
+                o = p < 0.5f ? 1.0f : -1.0f;
+                o += Polyblep(ch, p) - Polyblep(ch, t);
+                // leaky integrator, normalized as in Oscillator
+                o = phase_inc_[ch] * o
+                    + (1.0f - phase_inc_[ch]) * last_out_[ch];
+                last_out_[ch] = o;
+                return 4.0f * o;
+            case Oscillator::WAVE_POLYBLEP_SAW:
+                return 1.0f - 2.0f * p + Polyblep(ch, p);
+            case Oscillator::WAVE_POLYBLEP_SQUARE:
+            default:
+                t = p + (1.0f - pw_[ch]);
+                t = t >= 1.0f ? t - 1.0f : t;
+                o = p < pw_[ch] ? 1.0f : -1.0f;
+                o += Polyblep(ch, p) - Polyblep(ch, t);
+                return 0.707f * o;
+        }
+    }
+
+    /** Same correction as Oscillator's Polyblep, written with selects */
+    inline float Polyblep(size_t ch, float t)
+    {
+        const float dt   = phase_inc_[ch];
+        const float a    = t * inc_recip_[ch];
+        const float b    = (t - 1.0f) * inc_recip_[ch];
+        const float head = a + a - a * a - 1.0f;
+        const float tail = b * b + b + b + 1.0f;
+        return t < dt ? head : (t > 1.0f - dt ? tail : 0.0f);
+    }
+
+    uint8_t waveform_;
+    size_t  num_channels_;
+    float   sr_recip_;
+    float   phase_[max_channels];
+    float   phase_inc_[max_channels];
+    float   inc_recip_[max_channels];
+    float   amp_[max_channels];
+    float   pw_[max_channels];
+    float   last_out_[max_channels];
+};
+
+} // namespace daisysp
+#endif
+#endif
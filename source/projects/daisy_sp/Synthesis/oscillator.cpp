@@ -1,25 +1,28 @@
 #include "dsp.h"
 #include "oscillator.h"
+#include "profile.h"
 
 using namespace daisysp;
 static inline float Polyblep(float phase_inc, float t);
 
 float Oscillator::Process()
 {
-    float out, t;
+    DSY_PROFILE_SCOPE("Oscillator::Process");
+    const float phase = phase_.GetPhase();
+    float       out, t;
     switch(waveform_)
     {
-        case WAVE_SIN: out = sinf(phase_ * TWOPI_F); break;
+        case WAVE_SIN: out = sinf(phase * TWOPI_F); break;
         case WAVE_TRI:
-            t   = -1.0f + (2.0f * phase_);
+            t   = -1.0f + (2.0f * phase);
             out = 2.0f * (fabsf(t) - 0.5f);
             break;
-        case WAVE_SAW: out = -1.0f * (((phase_ * 2.0f)) - 1.0f); break;
-        case WAVE_RAMP: out = ((phase_ * 2.0f)) - 1.0f; break;
-        case WAVE_SQUARE: out = phase_ < pw_ ? (1.0f) : -1.0f; break;
+        case WAVE_SAW: out = -1.0f * (((phase * 2.0f)) - 1.0f); break;
+        case WAVE_RAMP: out = ((phase * 2.0f)) - 1.0f; break;
+        case WAVE_SQUARE: out = phase < pw_ ? (1.0f) : -1.0f; break;
         case WAVE_POLYBLEP_TRI:
-            t   = phase_;
-            out = phase_ < 0.5f ? 1.0f : -1.0f;
+            t   = phase;
+            out = phase < 0.5f ? 1.0f : -1.0f;
             out += Polyblep(phase_inc_, t);
             out -= Polyblep(phase_inc_, fmodf(t + 0.5f, 1.0f));
             // Leaky Integrator:
@@ -29,31 +32,25 @@ float Oscillator::Process()
             out *= 4.f; // normalize amplitude after leaky integration
             break;
         case WAVE_POLYBLEP_SAW:
-            t   = phase_;
+            t   = phase;
             out = (2.0f * t) - 1.0f;
             out -= Polyblep(phase_inc_, t);
             out *= -1.0f;
             break;
         case WAVE_POLYBLEP_SQUARE:
-            t   = phase_;
-            out = phase_ < pw_ ? 1.0f : -1.0f;
+            t   = phase;
+            out = phase < pw_ ? 1.0f : -1.0f;
             out += Polyblep(phase_inc_, t);
             out -= Polyblep(phase_inc_, fmodf(t + (1.0f - pw_), 1.0f));
             out *= 0.707f; // ?
             break;
         default: out = 0.0f; break;
     }
-    phase_ += phase_inc_;
-    if(phase_ > 1.0f)
-    {
-        phase_ -= 1.0f;
-        eoc_ = true;
-    }
-    else
-    {
-        eoc_ = false;
-    }
-    eor_ = (phase_ - phase_inc_ < 0.5f && phase_ >= 0.5f);
+    // wraps by overflow, see PhaseAccumulator. The half changes at the
+    // wrap and at the midpoint, in either direction.
+    const bool was_rising = phase_.IsFirstHalf();
+    eoc_                  = phase_.Advance();
+    eor_                  = was_rising != phase_.IsFirstHalf() && !eoc_;
 
     return out * amp_;
 }
@@ -3,6 +3,7 @@
 #define DSY_OSCILLATOR_H
 #include <stdint.h>
 #include "Utility/dsp.h"
+#include "Utility/phaseaccumulator.h"
 #ifdef __cplusplus
 
 namespace daisysp
@@ -46,8 +47,9 @@ class Oscillator
         freq_      = 100.0f;
         amp_       = 0.5f;
         pw_        = 0.5f;
-        phase_     = 0.0f;
+        phase_.Init();
         phase_inc_ = CalcPhaseInc(freq_);
+        phase_.SetIncrement(phase_inc_);
         waveform_  = WAVE_SIN;
         eoc_       = true;
         eor_       = true;
@@ -60,6 +62,7 @@ class Oscillator
     {
         freq_      = f;
         phase_inc_ = CalcPhaseInc(f);
+        phase_.SetIncrement(phase_inc_);
     }
 
 
@@ -86,11 +89,11 @@ class Oscillator
 
     /** Returns true if cycle rising.
     */
-    inline bool IsRising() { return phase_ < 0.5f; }
+    inline bool IsRising() { return phase_.IsFirstHalf(); }
 
     /** Returns true if cycle falling.
     */
-    inline bool IsFalling() { return phase_ >= 0.5f; }
+    inline bool IsFalling() { return !phase_.IsFirstHalf(); }
 
     /** Processes the waveform to be generated, returning one sample. This should be called once per sample period.
     */
@@ -99,16 +102,19 @@ class Oscillator
 
     /** Adds a value 0.0-1.0 (equivalent to 0.0-TWO_PI) to the current phase. Useful for PM and "FM" synthesis.
     */
-    void PhaseAdd(float _phase) { phase_ += _phase; }
+    void PhaseAdd(float _phase) { phase_.Add(_phase); }
     /** Resets the phase to the input argument. If no argumeNt is present, it will reset phase to 0.0;
     */
-    void Reset(float _phase = 0.0f) { phase_ = _phase; }
+    void Reset(float _phase = 0.0f) { phase_.Reset(_phase); }
 
   private:
     float   CalcPhaseInc(float f);
     uint8_t waveform_;
     float   amp_, freq_, pw_;
-    float   sr_, sr_recip_, phase_, phase_inc_;
+    float   sr_, sr_recip_, phase_inc_;
+
+    PhaseAccumulator phase_;
+
     float   last_out_, last_freq_;
     bool    eor_, eoc_;
 };
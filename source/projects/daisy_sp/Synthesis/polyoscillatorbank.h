@@ -0,0 +1,242 @@
+#pragma once
+#ifndef DSY_POLYOSCILLATORBANK_H
+#define DSY_POLYOSCILLATORBANK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Utility/dsp.h"
+#ifdef __cplusplus
+
+/** @file polyoscillatorbank.h */
+
+namespace daisysp
+{
+/**
+       @brief Polyphonic divide-down organ, num_voices OscillatorBank voices
+       @date Oct 2026
+       Each voice is the 7 registration saw and square mixture of
+       OscillatorBank. All voices share one registration and gain, and each
+       has its own frequency and level. \n
+       Voice state is kept as structure-of-arrays. Phase advance, segment
+       detection and BLEP correction run branch-free across voices, so the
+       compiler vectorizes them and a full organ costs about one voice per
+       SIMD lane. \n
+       The registration is turned into saw gains once per block for each of
+       the four octave shifts used above 1/16 of the sample rate (see
+       OscillatorBank), not once per voice. \n
+       num_voices must be 8, 16, 32 or 64.
+*/
+template <size_t num_voices>
+class PolyOscillatorBank
+{
+    static_assert(num_voices == 8 || num_voices == 16 || num_voices == 32
+                      || num_voices == 64,
+                  "PolyOscillatorBank supports 8, 16, 32 or 64 voices");
+
+  public:
+    PolyOscillatorBank() {}
+    ~PolyOscillatorBank() {}
+
+    /** Initializes all voices at 440 Hz and level 0, registration Saw 8'
+        \param sample_rate Audio engine sample rate
+    */
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+        gain_        = 1.0f;
+        for(size_t i = 0; i < 7; i++)
+        {
+            registration_[i] = 0.0f;
+        }
+        registration_[0] = 1.0f;
+        for(size_t v = 0; v < num_voices; v++)
+        {
+            phase_[v]   = 0.0f;
+            next_[v]    = 0.0f;
+            segment_[v] = 0;
+            level_[v]   = 0.0f;
+            shift_[v]   = 0;
+            SetFreq(v, 440.0f);
+        }
+        dirty_ = true;
+    }
+
+    /** Renders the sum of all voices
+        \param out size samples
+        \param size number of samples
+    */
+    void ProcessBlock(float *out, size_t size)
+    {
+        if(dirty_)
+        {
+            UpdateGains();
+        }
+
+        float s[num_voices];
+        for(size_t n = 0; n < size; n++)
+        {
+            for(size_t v = 0; v < num_voices; v++)
+            {
+                const float this_sample = next_[v];
+
+                // segments 0-7 of the 8' cycle, 8 wraps to 0. The flags
+                // below are 1.0 or 0.0 instead of branches.
+                float         phase = phase_[v] + freq_[v];
+                int32_t       seg   = (int32_t)phase;
+                const float   moved = (float)(seg != segment_[v]);
+                const int32_t wrap  = seg >> 3;
+                phase -= (float)(wrap << 3);
+                seg -= wrap << 3;
+
+                const float discontinuity
+                    = -moved
+                      * ((float)wrap * g8_[v]
+                         + (float)((seg & 3) == 0) * g4_[v]
+                         + (float)((seg & 1) == 0) * g2_[v] + g1_[v]);
+                const float t  = (phase - (float)seg) * inv_freq_[v];
+                const float t1 = 1.0f - t;
+
+                float next = -0.5f * t1 * t1 * discontinuity; // NextBlep
+                next += (phase - 4.0f) * g8_[v] * 0.125f;
+                next += (phase - (float)(seg & 4) - 2.0f) * g4_[v] * 0.25f;
+                next += (phase - (float)(seg & 6) - 1.0f) * g2_[v] * 0.5f;
+                next += (phase - (float)(seg & 7) - 0.5f) * g1_[v];
+
+                s[v] = 2.0f * (this_sample + 0.5f * t * t * discontinuity);
+                phase_[v]   = phase;
+                segment_[v] = seg;
+                next_[v]    = next;
+            }
+            out[n] = SumVoices(s);
+        }
+    }
+
+    /** Sets the frequency of one voice
+        \param voice 0 to num_voices - 1
+        \param freq Frequency in Hz
+    */
+    void SetFreq(size_t voice, float freq)
+    {
+        float f = fclamp(freq / sample_rate_, 0.0f, 0.5f) * 8.0f;
+
+        // play high notes as a higher harmonic of a lower wave, as in
+        // OscillatorBank
+        uint8_t shift = 0;
+        while(f > 0.5f)
+        {
+            shift++;
+            f *= 0.5f;
+        }
+        freq_[voice]     = f;
+        inv_freq_[voice] = f > 0.0f ? 1.0f / f : 0.0f;
+        if(shift != shift_[voice])
+        {
+            shift_[voice] = shift;
+            dirty_        = true;
+        }
+    }
+
+    /** Sets the level of one voice, 0 silences it */
+    void SetLevel(size_t voice, float level)
+    {
+        level_[voice] = level;
+        dirty_        = true;
+    }
+
+    /** Set amplitudes of the 7 registrations, shared by all voices.
+        0-6 are Saw 8', Square 8', Saw 4', Square 4', Saw 2', Square 2',
+        Saw 1'
+        \param amplitudes array of 7 amplitudes. Must sum to 1.
+    */
+    void SetAmplitudes(const float *amplitudes)
+    {
+        for(size_t i = 0; i < 7; i++)
+        {
+            registration_[i] = amplitudes[i];
+        }
+        dirty_ = true;
+    }
+
+    /** Set a single registration amplitude
+        \param amp Amplitude to set.
+        \param idx Which wave's amp to set
+    */
+    void SetSingleAmp(float amp, int idx)
+    {
+        if(idx < 0 || idx > 6)
+        {
+            return;
+        }
+        registration_[idx] = amp;
+        dirty_             = true;
+    }
+
+    /** Set overall gain.
+        \param gain Gain to set. 0-1.
+    */
+    void SetGain(float gain)
+    {
+        gain_  = fclamp(gain, 0.0f, 1.0f);
+        dirty_ = true;
+    }
+
+  private:
+    static const size_t kNumShifts = 4;
+
+    // saw gains for each octave shift, then per voice scaled by its level
+    void UpdateGains()
+    {
+        float gains[kNumShifts][4];
+        for(size_t s = 0; s < kNumShifts; s++)
+        {
+            float r[7];
+            for(size_t i = 0; i < 7; i++)
+            {
+                r[i] = i >= 2 * s ? registration_[i - 2 * s] : 0.0f;
+            }
+            gains[s][0] = (r[0] + 2.0f * r[1]) * gain_;
+            gains[s][1] = (r[2] - r[1] + 2.0f * r[3]) * gain_;
+            gains[s][2] = (r[4] - r[3] + 2.0f * r[5]) * gain_;
+            gains[s][3] = (r[6] - r[5]) * gain_;
+        }
+        for(size_t v = 0; v < num_voices; v++)
+        {
+            const float *g = gains[shift_[v]];
+            g8_[v]         = g[0] * level_[v];
+            g4_[v]         = g[1] * level_[v];
+            g2_[v]         = g[2] * level_[v];
+            g1_[v]         = g[3] * level_[v];
+        }
+        dirty_ = false;
+    }
+
+    // pairwise sum, written out so it vectorizes
+    static float SumVoices(float *x)
+    {
+        for(size_t n = num_voices / 2; n > 0; n /= 2)
+        {
+            for(size_t i = 0; i < n; i++)
+            {
+                x[i] += x[i + n];
+            }
+        }
+        return x[0];
+    }
+
+    float sample_rate_, gain_;
+    float registration_[7];
+    bool  dirty_;
+
+    // per voice lanes
+    float   phase_[num_voices];
+    float   next_[num_voices];
+    int32_t segment_[num_voices];
+    float   freq_[num_voices], inv_freq_[num_voices];
+    float   level_[num_voices];
+    uint8_t shift_[num_voices];
+    float   g8_[num_voices], g4_[num_voices], g2_[num_voices], g1_[num_voices];
+};
+
+} // namespace daisysp
+#endif
+#endif
@@ -0,0 +1,150 @@
+#include "dsp.h"
+#include "unisonsaw.h"
+#include <math.h>
+
+using namespace daisysp;
+
+void UnisonSaw::Init(float sample_rate)
+{
+    sample_rate_ = sample_rate;
+    freq_        = 220.0f;
+    detune_      = 0.2f;
+    curve_       = 1.0f;
+    spread_      = 1.0f;
+    num_voices_  = 7;
+
+    // golden ratio steps keep the voices from starting in phase
+    for(size_t i = 0; i < kMaxVoices; i++)
+    {
+        const float p = i * 0.618034f;
+        phase_[i]     = p - (int)p;
+        next_[i]      = phase_[i];
+    }
+    UpdateVoices();
+}
+
+void UnisonSaw::Process(float *left, float *right)
+{
+    ProcessBlock(left, right, 1);
+}
+
+// pairwise sum over the lanes, written out so it vectorizes
+static inline float SumLanes(float *x)
+{
+    for(size_t n = UnisonSaw::kMaxVoices / 2; n > 0; n /= 2)
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            x[i] += x[i + n];
+        }
+    }
+    return x[0];
+}
+
+void UnisonSaw::ProcessBlock(float *left, float *right, size_t size)
+{
+    float l[kMaxVoices], r[kMaxVoices];
+    for(size_t n = 0; n < size; n++)
+    {
+        for(size_t i = 0; i < kMaxVoices; i++)
+        {
+            // wrap is 1.0 or 0.0 rather than a branch, so the lanes vectorize
+            float       p    = phase_[i] + inc_[i];
+            const float wrap = (float)(int32_t)p; // p < 1.25
+            p -= wrap;
+            const float t  = p * inv_inc_[i];
+            const float t1 = 1.0f - t;
+
+            // ThisBlepSample and NextBlepSample of the falling edge
+            const float s = next_[i] - wrap * 0.5f * t * t;
+            next_[i]      = p + wrap * 0.5f * t1 * t1;
+            phase_[i]     = p;
+
+            const float out = 2.0f * s - 1.0f;
+            l[i]            = out * gain_l_[i];
+            r[i]            = out * gain_r_[i];
+        }
+        left[n]  = SumLanes(l);
+        right[n] = SumLanes(r);
+    }
+}
+
+void UnisonSaw::SetFreq(float freq)
+{
+    freq_ = freq;
+    UpdateIncrements();
+}
+
+void UnisonSaw::SetNumVoices(size_t num_voices)
+{
+    num_voices_ = num_voices < 1            ? 1
+                  : num_voices > kMaxVoices ? kMaxVoices
+                                            : num_voices;
+    UpdateVoices();
+}
+
+void UnisonSaw::SetDetune(float semitones)
+{
+    detune_ = fclamp(semitones, 0.0f, 12.0f);
+    UpdateVoices();
+}
+
+void UnisonSaw::SetDetuneCurve(float curve)
+{
+    curve_ = fclamp(curve, 0.25f, 4.0f);
+    UpdateVoices();
+}
+
+void UnisonSaw::SetSpread(float spread)
+{
+    spread_ = fclamp(spread, 0.0f, 1.0f);
+    UpdateVoices();
+}
+
+void UnisonSaw::SetPhase(size_t voice, float phase)
+{
+    if(voice < kMaxVoices)
+    {
+        phase_[voice] = fclamp(phase, 0.0f, 0.999999f);
+        next_[voice]  = phase_[voice];
+    }
+}
+
+void UnisonSaw::UpdateVoices()
+{
+    // uncorrelated voices add up as sqrt(n), a single centered voice
+    // comes out at full scale on both sides
+    const float norm = sqrtf(2.0f / num_voices_);
+    for(size_t i = 0; i < kMaxVoices; i++)
+    {
+        if(i >= num_voices_)
+        {
+            ratio_[i] = 0.0f;
+            gain_l_[i] = gain_r_[i] = 0.0f;
+            continue;
+        }
+        // position -1 to 1 across the stack
+        const float u
+            = num_voices_ > 1 ? 2.0f * i / (num_voices_ - 1) - 1.0f : 0.0f;
+        const float offset = detune_ * powf(fabsf(u), curve_);
+        ratio_[i]          = SemitonesToRatio(u < 0.0f ? -offset : offset);
+
+        // alternate sides so each side gets sharp and flat voices
+        const float pan   = spread_ * u * (i & 1 ? -1.0f : 1.0f);
+        const float angle = (pan + 1.0f) * (PI_F * 0.25f);
+        gain_l_[i]        = cosf(angle) * norm;
+        gain_r_[i]        = sinf(angle) * norm;
+    }
+    UpdateIncrements();
+}
+
+void UnisonSaw::UpdateIncrements()
+{
+    const float f0 = freq_ / sample_rate_;
+    for(size_t i = 0; i < kMaxVoices; i++)
+    {
+        // the BLEP needs at least four samples per cycle
+        inc_[i]     = fclamp(f0 * ratio_[i], 0.0f, 0.25f);
+        inv_inc_[i] = inc_[i] > 0.0f ? 1.0f / inc_[i] : 0.0f;
+    }
+}
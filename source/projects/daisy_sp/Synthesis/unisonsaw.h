@@ -0,0 +1,108 @@
+#pragma once
+#ifndef DSY_UNISONSAW_H
+#define DSY_UNISONSAW_H
+
+#include <stdint.h>
+#include <stddef.h>
+#ifdef __cplusplus
+
+/** @file unisonsaw.h */
+
+namespace daisysp
+{
+/**
+       @brief Unison sawtooth oscillator, up to 16 detuned voices in stereo
+       @date Oct 2026
+       One object in place of a stack of VariableSawOscillator or BlOsc
+       instances for supersaw leads and pads. \n
+       Voice state is kept as structure-of-arrays over a fixed 16 lanes, so
+       each sample is one pass of straight-line arithmetic across the lanes
+       that the compiler vectorizes. Unused lanes are silent, and the cost
+       does not depend on the number of voices. \n
+       Each voice is a polyBLEP corrected saw, as in VariableSawOscillator,
+       with one sample of latency. \n
+       Voices are spread symmetrically around the root frequency. The detune
+       curve shapes that spread, and the stereo spread pans voices
+       alternately left and right.
+*/
+class UnisonSaw
+{
+  public:
+    UnisonSaw() {}
+    ~UnisonSaw() {}
+
+    static constexpr size_t kMaxVoices = 16;
+
+    /** Initializes the oscillator
+        \param sample_rate Audio engine sample rate
+
+        Defaults:
+        - 7 voices at 220 Hz
+        - detune = 0.2 semitones, curve = 1.0 (even spacing)
+        - spread = 1.0
+        - voice phases spread evenly over a cycle
+    */
+    void Init(float sample_rate);
+
+    /** Renders one stereo sample
+        \param left left output
+        \param right right output
+    */
+    void Process(float *left, float *right);
+
+    /** Renders a block, buffers must not alias
+        \param left size samples of left output
+        \param right size samples of right output
+        \param size number of samples
+    */
+    void ProcessBlock(float *left, float *right, size_t size);
+
+    /** Sets the root frequency in Hz */
+    void SetFreq(float freq);
+
+    /** Sets the number of voices, 1 to 16 */
+    void SetNumVoices(size_t num_voices);
+
+    /** Sets the detune of the outermost voices
+        \param semitones offset either side of the root, 0 to 12
+    */
+    void SetDetune(float semitones);
+
+    /** Sets the shape of the detune spread
+        \param curve exponent on the voice position, 1.0 spaces voices
+               evenly, higher values cluster them around the root and
+               leave the outer voices wide. Range 0.25 to 4.0.
+    */
+    void SetDetuneCurve(float curve);
+
+    /** Sets the stereo width
+        \param spread 0.0 (mono) to 1.0 (outer voices hard left and right)
+    */
+    void SetSpread(float spread);
+
+    /** Sets the phase of one voice, e.g. to retrigger in phase
+        \param voice 0 to 15
+        \param phase 0.0 to 1.0
+    */
+    void SetPhase(size_t voice, float phase);
+
+  private:
+    void UpdateVoices();
+    void UpdateIncrements();
+
+    float  sample_rate_, freq_, detune_, curve_, spread_;
+    size_t num_voices_;
+
+    // per voice lanes
+    float phase_[kMaxVoices];
+    float next_[kMaxVoices]; // naive sample delayed for the BLEP
+    float ratio_[kMaxVoices];
+    float inc_[kMaxVoices];
+    float inv_inc_[kMaxVoices];
+    float gain_l_[kMaxVoices];
+    float gain_r_[kMaxVoices];
+};
+
+} // namespace daisysp
+#endif
+#endif
@@ -0,0 +1,220 @@
+#include "dsp.h"
+#include "wavetableosc.h"
+#include "phaseaccumulator.h"
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846 /* pi */
+#endif
+
+using namespace daisysp;
+
+bool WavetableBank::Init(float *memory,
+                         size_t size,
+                         size_t table_size,
+                         size_t num_tables)
+{
+    if(table_size < 4 || (table_size & (table_size - 1)) != 0
+       || size < GetRequiredSize(table_size, num_tables))
+    {
+        return false;
+    }
+    memory_     = memory;
+    table_size_ = table_size;
+    num_tables_ = num_tables;
+    num_levels_ = GetNumLevels(table_size);
+    table_bits_ = 0;
+    while((size_t(1) << table_bits_) < table_size)
+    {
+        table_bits_++;
+    }
+    for(size_t i = 0; i < num_tables_; i++)
+    {
+        Clear(i);
+        Finish(i);
+    }
+    return true;
+}
+
+void WavetableBank::LoadWaveform(size_t table, const float *cycle)
+{
+    if(table >= num_tables_)
+    {
+        return;
+    }
+    Clear(table);
+    const double w     = 2.0 * M_PI / table_size_;
+    const double scale = 2.0 / table_size_;
+    for(size_t k = 1; k <= MaxHarmonic(0); k++)
+    {
+        // DFT bin k by a rotating phasor, in double
+        const double cw = cos(w * k), sw = sin(w * k);
+        double       c = 1.0, s = 0.0, re = 0.0, im = 0.0;
+        for(size_t n = 0; n < table_size_; n++)
+        {
+            re += cycle[n] * c;
+            im += cycle[n] * s;
+            const double t = c * cw - s * sw;
+            s              = s * cw + c * sw;
+            c              = t;
+        }
+        AddHarmonic(table, k, (float)(re * scale), (float)(im * scale));
+    }
+    Finish(table);
+}
+
+void WavetableBank::LoadHarmonics(size_t       table,
+                                  const float *amplitudes,
+                                  size_t       num_harmonics)
+{
+    if(table >= num_tables_)
+    {
+        return;
+    }
+    Clear(table);
+    for(size_t k = 1; k <= num_harmonics && k <= MaxHarmonic(0); k++)
+    {
+        if(amplitudes[k - 1] != 0.0f)
+        {
+            AddHarmonic(table, k, 0.0f, amplitudes[k - 1]);
+        }
+    }
+    Finish(table);
+}
+
+size_t WavetableBank::GetLevel(float freq) const
+{
+    // the first level whose top harmonic stays below Nyquist
+    size_t level = 0;
+    while(level + 1 < num_levels_ && MaxHarmonic(level) * freq > 0.5f)
+    {
+        level++;
+    }
+    return level;
+}
+
+void WavetableBank::Clear(size_t table)
+{
+    for(size_t l = 0; l < num_levels_; l++)
+    {
+        float *t = Table(table, l);
+        for(size_t n = 0; n <= table_size_; n++)
+        {
+            t[n] = 0.0f;
+        }
+    }
+}
+
+// adds one harmonic to every level that holds it
+void WavetableBank::AddHarmonic(size_t table,
+                                size_t harmonic,
+                                float  cos_amp,
+                                float  sin_amp)
+{
+    size_t levels = 0;
+    while(levels < num_levels_ && harmonic <= MaxHarmonic(levels))
+    {
+        levels++;
+    }
+
+    const double w  = 2.0 * M_PI * harmonic / table_size_;
+    const double cw = cos(w), sw = sin(w);
+    double       c = 1.0, s = 0.0;
+    for(size_t n = 0; n < table_size_; n++)
+    {
+        const float v = cos_amp * (float)c + sin_amp * (float)s;
+        for(size_t l = 0; l < levels; l++)
+        {
+            Table(table, l)[n] += v;
+        }
+        const double t = c * cw - s * sw;
+        s              = s * cw + c * sw;
+        c              = t;
+    }
+}
+
+void WavetableBank::Finish(size_t table)
+{
+    for(size_t l = 0; l < num_levels_; l++)
+    {
+        float *t        = Table(table, l);
+        t[table_size_] = t[0];
+    }
+}
+
+void WavetableOsc::Init(float sample_rate, const WavetableBank *bank)
+{
+    sample_rate_ = sample_rate;
+    bank_        = bank;
+    amp_         = 0.5f;
+    position_    = 0.0f;
+    phase_       = 0;
+    table_       = 0;
+    xfade_       = 0.0f;
+    gain_        = amp_;
+    SetFreq(220.0f);
+}
+
+float WavetableOsc::Process()
+{
+    float out;
+    ProcessBlock(&out, 1);
+    return out;
+}
+
+void WavetableOsc::ProcessBlock(float *out, size_t size)
+{
+    const size_t num_tables = bank_->GetNumTables();
+
+    // table pair and crossfade for the end of this block, ramped from the
+    // last block unless the pair changed
+    const float  pos   = position_ * (num_tables - 1);
+    size_t       table = (size_t)pos;
+    table              = table + 1 < num_tables ? table : num_tables - 1;
+    const float xfade  = table + 1 < num_tables ? pos - table : 0.0f;
+    float       x      = table == table_ ? xfade_ : xfade;
+    const float dx     = (xfade - x) / size;
+    float       g      = gain_;
+    const float dg     = (amp_ - g) / size;
+    table_             = table;
+    xfade_             = xfade;
+    gain_              = amp_;
+
+    const float *a = bank_->GetTable(table, level_);
+    const float *b
+        = bank_->GetTable(table + 1 < num_tables ? table + 1 : table, level_);
+
+    const uint32_t bits  = bank_->GetTableBits();
+    const uint32_t shift = 32 - bits;
+
+    uint32_t phase = phase_;
+    for(size_t n = 0; n < size; n++)
+    {
+        const uint32_t i    = phase >> shift;
+        const float    frac = PhaseToFloat(phase << bits);
+        const float    va   = a[i] + (a[i + 1] - a[i]) * frac;
+        const float    vb   = b[i] + (b[i + 1] - b[i]) * frac;
+        out[n]              = (va + (vb - va) * x) * g;
+        x += dx;
+        g += dg;
+        phase += increment_;
+    }
+    phase_ = phase;
+}
+
+void WavetableOsc::SetFreq(float freq)
+{
+    freq_      = fclamp(freq / sample_rate_, 0.0f, 0.5f);
+    increment_ = PhaseFromFloat(freq_);
+    level_     = bank_->GetLevel(freq_);
+}
+
+void WavetableOsc::SetPosition(float position)
+{
+    position_ = fclamp(position, 0.0f, 1.0f);
+}
+
+void WavetableOsc::Reset(float phase)
+{
+    phase_ = PhaseFromFloat(phase);
+}
@@ -0,0 +1,186 @@
+#pragma once
+#ifndef DSY_WAVETABLEOSC_H
+#define DSY_WAVETABLEOSC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#ifdef __cplusplus
+
+/** @file wavetableosc.h */
+
+namespace daisysp
+{
+/**
+       @brief Set of band-limited, per-octave mipmapped single cycle tables
+       @date Oct 2026
+       Built once from waveforms or harmonic amplitudes, then shared read
+       only by any number of WavetableOsc voices. \n
+       Each table is stored at a number of levels. Level 0 holds harmonics up
+       to a quarter of the table size, so it is 2x oversampled for linear
+       interpolation, and each further level holds half the harmonics of the
+       one before, down to the fundamental alone. \n
+       The memory is provided by the caller, see GetRequiredSize(). A 2048
+       sample table has 10 levels, about 80 kB per table.
+
+       declaration example:
+
+       static float memory[WavetableBank::GetRequiredSize(2048, 4)];
+       WavetableBank bank;
+       bank.Init(memory, DSY_COUNTOF(memory), 2048, 4);
+       bank.LoadWaveform(0, my_cycle);
+*/
+class WavetableBank
+{
+  public:
+    WavetableBank() {}
+    ~WavetableBank() {}
+
+    /** Number of mip levels for a table size, a power of two >= 4 */
+    static constexpr size_t GetNumLevels(size_t table_size)
+    {
+        return table_size <= 4 ? 1 : 1 + GetNumLevels(table_size / 2);
+    }
+
+    /** Number of floats the memory passed to Init must hold
+        \param table_size samples per cycle, a power of two >= 4
+        \param num_tables number of waveforms
+    */
+    static constexpr size_t GetRequiredSize(size_t table_size,
+                                            size_t num_tables)
+    {
+        // one guard sample per level for the interpolation
+        return num_tables * GetNumLevels(table_size) * (table_size + 1);
+    }
+
+    /** Sets up the bank over caller memory, all tables silent
+        \param memory storage, kept in either main() or global space
+        \param size number of floats in memory
+        \param table_size samples per cycle, a power of two >= 4
+        \param num_tables number of waveforms
+        \return false, with nothing set up, if table_size is not a power of
+                two or memory is too small
+    */
+    bool Init(float *memory, size_t size, size_t table_size, size_t num_tables);
+
+    /** Loads one table from a single cycle. The cycle is band-limited per
+        level by a DFT, and its DC offset is removed. Takes
+        table_size * table_size / 2 multiplies, so call it at setup, not
+        from the audio callback.
+        \param table 0 to num_tables - 1
+        \param cycle table_size samples, must not be in the bank memory
+    */
+    void LoadWaveform(size_t table, const float *cycle);
+
+    /** Loads one table as a sum of sine harmonics
+        \param table 0 to num_tables - 1
+        \param amplitudes amplitude of harmonics 1 to num_harmonics
+        \param num_harmonics harmonics above the level 0 limit are dropped
+    */
+    void LoadHarmonics(size_t table,
+                       const float *amplitudes,
+                       size_t       num_harmonics);
+
+    /** Returns the level to play at a frequency without aliasing
+        \param freq frequency normalized to the sample rate, 0 to 0.5
+    */
+    size_t GetLevel(float freq) const;
+
+    /** Returns table_size + 1 samples, the last repeats the first */
+    inline const float *GetTable(size_t table, size_t level) const
+    {
+        return memory_ + (table * num_levels_ + level) * (table_size_ + 1);
+    }
+
+    inline size_t GetTableSize() const { return table_size_; }
+    inline size_t GetTableBits() const { return table_bits_; }
+    inline size_t GetNumTables() const { return num_tables_; }
+    inline size_t GetNumLevels() const { return num_levels_; }
+
+  private:
+    // highest harmonic stored at a level
+    inline size_t MaxHarmonic(size_t level) const
+    {
+        return (table_size_ / 4) >> level;
+    }
+
+    inline float *Table(size_t table, size_t level)
+    {
+        return memory_ + (table * num_levels_ + level) * (table_size_ + 1);
+    }
+
+    void Clear(size_t table);
+    void AddHarmonic(size_t table, size_t harmonic, float cos_amp, float sin_amp);
+    void Finish(size_t table);
+
+    float *memory_;
+    size_t table_size_, table_bits_, num_tables_, num_levels_;
+};
+
+/**
+       @brief Band-limited wavetable oscillator
+       @date Oct 2026
+       Plays a WavetableBank with linear interpolation, picking the mip
+       level for the current frequency so no harmonic passes Nyquist. \n
+       The position morphs across the tables of the bank by crossfading the
+       two nearest ones. Position and amplitude changes are ramped over each
+       block. \n
+       A voice is a table read per table and a handful of multiplies per
+       sample, with no per-sample band limiting, so hundreds of voices can
+       share one bank.
+*/
+class WavetableOsc
+{
+  public:
+    WavetableOsc() {}
+    ~WavetableOsc() {}
+
+    /** Initializes the oscillator
+        \param sample_rate Audio engine sample rate
+        \param bank tables to play, must outlive the oscillator
+
+        Defaults:
+        - 220 Hz, amplitude 0.5
+        - position 0, the first table
+    */
+    void Init(float sample_rate, const WavetableBank *bank);
+
+    /** Get the next floating point sample */
+    float Process();
+
+    /** Renders a block
+        \param out size samples
+        \param size number of samples
+    */
+    void ProcessBlock(float *out, size_t size);
+
+    /** Sets the frequency in Hz, 0 to Nyquist */
+    void SetFreq(float freq);
+
+    /** Sets the output amplitude */
+    inline void SetAmp(float amp) { amp_ = amp; }
+
+    /** Sets the morph position
+        \param position 0.0 (first table) to 1.0 (last table)
+    */
+    void SetPosition(float position);
+
+    /** Restarts the cycle
+        \param phase 0.0 to 1.0
+    */
+    void Reset(float phase = 0.0f);
+
+  private:
+    const WavetableBank *bank_;
+
+    float    sample_rate_, freq_, amp_, position_;
+    uint32_t phase_, increment_;
+    size_t   level_;
+
+    // values reached at the end of the last block, ramps start from here
+    size_t table_;
+    float  xfade_, gain_;
+};
+
+} // namespace daisysp
+#endif
+#endif
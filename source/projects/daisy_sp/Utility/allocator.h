@@ -0,0 +1,119 @@
+#pragma once
+#ifndef DSY_ALLOCATOR_H
+#define DSY_ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace daisysp
+{
+/** Alignment used for every block handed out by an Allocator */
+static constexpr size_t kCacheLineSize = 64;
+
+/** Rounds a byte count up to a multiple of align (a power of two) */
+constexpr size_t AlignedSize(size_t bytes, size_t align = kCacheLineSize)
+{
+    return (bytes + align - 1) & ~(align - 1);
+}
+
+/** Memory source passed to Init() by modules whose buffers depend on the
+    sample rate. Modules ask for exactly what they need once, at Init, and
+    never free: the owner of the allocator releases everything at once.
+
+    Modules offering an Allocator overload of Init also have a static
+    GetRequiredMemory(sample_rate), so a pool can be sized up front
+    (exact for a cache-line aligned pool).
+
+    Defining DSY_NO_EMBEDDED_BUFFERS removes the fixed 48 kHz buffers those
+    modules otherwise carry, leaving the Allocator overload as the only Init.
+*/
+class Allocator
+{
+  public:
+    virtual ~Allocator() {}
+
+    /** Returns size bytes aligned to alignment, or nullptr when exhausted.
+        \param size bytes requested
+        \param alignment power of two, defaults to a cache line
+    */
+    virtual void *Allocate(size_t size, size_t alignment = kCacheLineSize) = 0;
+
+    /** Typed helper, returns count zero-initialized elements of T */
+    template <typename T>
+    T *AllocateArray(size_t count)
+    {
+        const size_t align
+            = alignof(T) > kCacheLineSize ? alignof(T) : kCacheLineSize;
+        T *ptr = static_cast<T *>(Allocate(count * sizeof(T), align));
+        if(ptr)
+        {
+            for(size_t i = 0; i < count; i++)
+            {
+                ptr[i] = T(0);
+            }
+        }
+        return ptr;
+    }
+};
+
+/** Bump allocator over a caller-provided buffer.
+
+    Allocation is a pointer increment; nothing is freed individually.
+    Reset() hands the whole buffer out again, so a voice or patch can be
+    re-initialized at another sample rate without touching the heap.
+
+    declaration example:
+
+    static uint8_t pool[1 << 20];
+    ArenaAllocator arena;
+    arena.Init(pool, sizeof(pool));
+    reverb.Init(sample_rate, arena);
+*/
+class ArenaAllocator : public Allocator
+{
+  public:
+    ArenaAllocator() : base_(nullptr), capacity_(0), used_(0) {}
+    ~ArenaAllocator() {}
+
+    /** Sets the buffer to allocate from
+        \param buffer start of the pool
+        \param size pool size in bytes
+    */
+    void Init(void *buffer, size_t size)
+    {
+        base_     = static_cast<uint8_t *>(buffer);
+        capacity_ = size;
+        used_     = 0;
+    }
+
+    void *Allocate(size_t size, size_t alignment = kCacheLineSize) override
+    {
+        const uintptr_t base    = reinterpret_cast<uintptr_t>(base_);
+        const uintptr_t aligned = (base + used_ + alignment - 1)
+                                  & ~(uintptr_t)(alignment - 1);
+        const size_t offset = aligned - base;
+        if(base_ == nullptr || offset + size > capacity_)
+        {
+            return nullptr;
+        }
+        used_ = offset + size;
+        return base_ + offset;
+    }
+
+    /** Releases every allocation at once */
+    void Reset() { used_ = 0; }
+
+    /** Bytes handed out so far, including alignment padding */
+    size_t GetUsed() const { return used_; }
+
+    /** Total size of the pool in bytes */
+    size_t GetCapacity() const { return capacity_; }
+
+  private:
+    uint8_t *base_;
+    size_t   capacity_;
+    size_t   used_;
+};
+
+} // namespace daisysp
+#endif
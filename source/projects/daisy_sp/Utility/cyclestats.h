@@ -0,0 +1,245 @@
+#pragma once
+#ifndef DSY_CYCLESTATS_H
+#define DSY_CYCLESTATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <chrono>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define DSY_CYCLES_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define DSY_CYCLES_TSC
+#endif
+
+namespace daisysp
+{
+/** Reads a free running monotonic tick counter.
+    The TSC on x86, the virtual counter on aarch64, steady_clock
+    nanoseconds elsewhere. Use CycleStats::TicksPerSecond to convert.
+*/
+inline uint64_t ReadCycleCounter()
+{
+#if defined(DSY_CYCLES_TSC)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t t;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+/** Timing statistics for a periodic call such as an audio callback.
+
+    One thread (the audio thread) records, any other thread reads, without
+    locks: every field is a relaxed atomic written only by the recorder,
+    so recording is a handful of plain loads and stores. Durations go into
+    a histogram with four buckets per octave, percentiles are therefore
+    reported within 19% (the upper edge of their bucket).
+
+    usage:
+
+    void AudioCallback(...)
+    {
+        CycleStats::Scope timer(stats);
+        ...
+    }
+
+    and from the UI thread: stats.GetMean(), stats.GetPercentile(0.99f).
+*/
+class CycleStats
+{
+  public:
+    CycleStats() {}
+    ~CycleStats() {}
+
+    /** Times its own lifetime into a CycleStats */
+    class Scope
+    {
+      public:
+        explicit Scope(CycleStats &stats)
+        : stats_(stats), start_(ReadCycleCounter())
+        {
+        }
+        ~Scope() { stats_.Record(ReadCycleCounter() - start_); }
+
+      private:
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        CycleStats &stats_;
+        uint64_t    start_;
+    };
+
+    /** Clears all statistics, call before recording starts */
+    void Init()
+    {
+        Clear();
+        reset_.store(false, std::memory_order_relaxed);
+        TicksPerSecond(); // start calibrating early
+    }
+
+    /** Adds one duration, recorder thread only
+        \param ticks elapsed ReadCycleCounter ticks
+    */
+    void Record(uint64_t ticks)
+    {
+        if(reset_.load(std::memory_order_relaxed))
+        {
+            Clear();
+            reset_.store(false, std::memory_order_relaxed);
+        }
+        Bump(count_, 1);
+        Bump(sum_, ticks);
+        if(ticks > max_.load(std::memory_order_relaxed))
+        {
+            max_.store(ticks, std::memory_order_relaxed);
+        }
+        std::atomic<uint32_t> &bucket = hist_[Bucket(ticks)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+    }
+
+    /** Asks the recorder to clear the statistics before its next Record */
+    void Reset() { reset_.store(true, std::memory_order_relaxed); }
+
+    /** Number of recorded calls */
+    uint64_t GetCount() const
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    /** Mean duration in seconds */
+    double GetMean() const
+    {
+        const uint64_t n = GetCount();
+        return n ? ToSeconds((double)sum_.load(std::memory_order_relaxed) / n)
+                 : 0.0;
+    }
+
+    /** Longest duration in seconds */
+    double GetMax() const
+    {
+        return ToSeconds((double)max_.load(std::memory_order_relaxed));
+    }
+
+    /** Duration in seconds that a fraction p of calls stayed under
+        \param p range 0.0 to 1.0, e.g. 0.99
+    */
+    double GetPercentile(float p) const
+    {
+        uint64_t total = 0;
+        for(size_t i = 0; i < kNumBuckets; i++)
+        {
+            total += hist_[i].load(std::memory_order_relaxed);
+        }
+        const uint64_t rank = (uint64_t)(p * (double)total + 0.5);
+        const uint64_t max  = max_.load(std::memory_order_relaxed);
+        uint64_t       acc  = 0;
+        for(size_t i = 0; i < kNumBuckets; i++)
+        {
+            acc += hist_[i].load(std::memory_order_relaxed);
+            if(acc > 0 && acc >= rank)
+            {
+                const uint64_t edge = UpperEdge(i);
+                return ToSeconds((double)(edge < max ? edge : max));
+            }
+        }
+        return GetMax();
+    }
+
+    /** Rate of ReadCycleCounter, measured against steady_clock since the
+        first call. The first call blocks for a few milliseconds.
+    */
+    static double TicksPerSecond()
+    {
+        typedef std::chrono::steady_clock clock;
+        static const uint64_t          t0 = ReadCycleCounter();
+        static const clock::time_point c0 = clock::now();
+
+        uint64_t          t1;
+        clock::time_point c1;
+        do
+        {
+            t1 = ReadCycleCounter();
+            c1 = clock::now();
+        } while(c1 - c0 < std::chrono::milliseconds(5));
+        const std::chrono::duration<double> elapsed = c1 - c0;
+        return (double)(t1 - t0) / elapsed.count();
+    }
+
+  private:
+    static const size_t kBucketsPerOctave = 4;
+    static const size_t kNumBuckets       = 48 * kBucketsPerOctave;
+
+    // single writer, so no read-modify-write instruction is needed
+    static void Bump(std::atomic<uint64_t> &a, uint64_t v)
+    {
+        a.store(a.load(std::memory_order_relaxed) + v,
+                std::memory_order_relaxed);
+    }
+
+    static size_t Msb(uint64_t v)
+    {
+        size_t msb = 0;
+        for(size_t shift = 32; shift > 0; shift >>= 1)
+        {
+            if(v >> shift)
+            {
+                v >>= shift;
+                msb += shift;
+            }
+        }
+        return msb;
+    }
+
+    // 0..3 map directly, then four buckets per power of two
+    static size_t Bucket(uint64_t ticks)
+    {
+        if(ticks < kBucketsPerOctave)
+        {
+            return ticks;
+        }
+        const size_t msb    = Msb(ticks);
+        const size_t bucket = (msb - 1) * kBucketsPerOctave
+                              + ((ticks >> (msb - 2)) & 3);
+        return bucket < kNumBuckets ? bucket : kNumBuckets - 1;
+    }
+
+    static uint64_t UpperEdge(size_t bucket)
+    {
+        if(bucket < kBucketsPerOctave)
+        {
+            return bucket;
+        }
+        const size_t msb = bucket / kBucketsPerOctave + 1;
+        return (uint64_t)(5 + bucket % kBucketsPerOctave) << (msb - 2);
+    }
+
+    static double ToSeconds(double ticks) { return ticks / TicksPerSecond(); }
+
+    void Clear()
+    {
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+        for(size_t i = 0; i < kNumBuckets; i++)
+        {
+            hist_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint64_t> count_, sum_, max_;
+    std::atomic<uint32_t> hist_[kNumBuckets];
+    std::atomic<bool>     reset_;
+};
+
+} // namespace daisysp
+#endif
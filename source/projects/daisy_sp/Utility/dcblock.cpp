@@ -1,5 +1,6 @@
 #include <math.h>
 #include "dcblock.h"
+#include "denormal.h"
 
 using namespace daisysp;
 
@@ -14,7 +15,7 @@ float DcBlock::Process(float in)
 {
     float out;
     out     = in - input_ + (gain_ * output_);
-    output_ = out;
+    output_ = FlushDenormal(out);
     input_  = in;
     return out;
 }
@@ -3,8 +3,12 @@
 #define DSY_DELAY_H
 #include <stdlib.h>
 #include <stdint.h>
+#include "Utility/allocator.h"
 namespace daisysp
 {
+/* use this as the max_size parameter to indicate user-provided memory storage */
+#define DELAYLINE_USER_MEMORY 0
+
 /** Simple Delay line.
 November 2019
 
@@ -117,5 +121,148 @@ class DelayLine
     size_t delay_;
     T      line_[max_size];
 };
+
+/** Delay line over user-provided memory.
+
+Same interface as DelayLine<T, max_size>, but the length is chosen at
+Init, from a buffer or from an Allocator, so it can follow the sample rate.
+
+declaration example: (1 second of floats at any sample rate)
+
+DelayLine<float, DELAYLINE_USER_MEMORY> del;
+del.Init(allocator, (size_t)sample_rate);
+*/
+template <typename T>
+class DelayLine<T, DELAYLINE_USER_MEMORY>
+{
+  public:
+    DelayLine() : line_(nullptr), size_(0) {}
+    ~DelayLine() {}
+
+    /** Uses buffer as the delay memory, then Reset()
+        \param buffer at least size elements
+        \param size length of the delay line in samples
+    */
+    void Init(T *buffer, size_t size)
+    {
+        line_ = buffer;
+        size_ = buffer ? size : 0;
+        Reset();
+    }
+
+    /** Requests size samples from allocator, then Reset()
+        \return false if the allocator is exhausted, the line is then
+        empty and must not be read or written
+    */
+    bool Init(Allocator &allocator, size_t size)
+    {
+        Init(allocator.AllocateArray<T>(size), size);
+        return line_ != nullptr;
+    }
+
+    /** Bytes taken from an Allocator by Init for size samples */
+    static constexpr size_t GetRequiredMemory(size_t size)
+    {
+        return AlignedSize(size * sizeof(T));
+    }
+
+    /** Length of the delay line in samples */
+    inline size_t GetSize() const { return size_; }
+
+    /** clears buffer, sets write ptr to 0, and delay to 1 sample.
+    */
+    void Reset()
+    {
+        for(size_t i = 0; i < size_; i++)
+        {
+            line_[i] = T(0);
+        }
+        write_ptr_ = 0;
+        delay_     = 1;
+        frac_      = 0.0f;
+    }
+
+    /** sets the delay time in samples
+    */
+    inline void SetDelay(size_t delay)
+    {
+        frac_  = 0.0f;
+        delay_ = delay < size_ ? delay : (size_ > 0 ? size_ - 1 : 0);
+    }
+
+    /** sets the delay time in samples, with a fractional component
+    */
+    inline void SetDelay(float delay)
+    {
+        int32_t int_delay = static_cast<int32_t>(delay);
+        frac_             = delay - static_cast<float>(int_delay);
+        delay_ = static_cast<size_t>(int_delay) < size_
+                     ? int_delay
+                     : (size_ > 0 ? size_ - 1 : 0);
+    }
+
+    /** writes the sample of type T to the delay line, and advances the write ptr
+    */
+    inline void Write(const T sample)
+    {
+        line_[write_ptr_] = sample;
+        write_ptr_        = (write_ptr_ == 0 ? size_ : write_ptr_) - 1;
+    }
+
+    /** returns the next sample of type T in the delay line, interpolated if necessary.
+    */
+    inline const T Read() const
+    {
+        T a = line_[Wrap(write_ptr_ + delay_)];
+        T b = line_[Wrap(write_ptr_ + delay_ + 1)];
+        return a + (b - a) * frac_;
+    }
+
+    /** Read from a set location */
+    inline const T Read(float delay) const
+    {
+        int32_t delay_integral   = static_cast<int32_t>(delay);
+        float   delay_fractional = delay - static_cast<float>(delay_integral);
+        const T a = line_[Wrap(write_ptr_ + delay_integral)];
+        const T b = line_[Wrap(write_ptr_ + delay_integral + 1)];
+        return a + (b - a) * delay_fractional;
+    }
+
+    inline const T ReadHermite(float delay) const
+    {
+        int32_t delay_integral   = static_cast<int32_t>(delay);
+        float   delay_fractional = delay - static_cast<float>(delay_integral);
+
+        size_t      t     = write_ptr_ + delay_integral + size_;
+        const T     xm1   = line_[Wrap(t - 1)];
+        const T     x0    = line_[Wrap(t)];
+        const T     x1    = line_[Wrap(t + 1)];
+        const T     x2    = line_[Wrap(t + 2)];
+        const float c     = (x1 - xm1) * 0.5f;
+        const float v     = x0 - x1;
+        const float w     = c + v;
+        const float a     = w + v + (x2 - x0) * 0.5f;
+        const float b_neg = w + a;
+        const float f     = delay_fractional;
+        return (((a * f) - b_neg) * f + c) * f + x0;
+    }
+
+    inline const T Allpass(const T sample, size_t delay, const T coefficient)
+    {
+        T read  = line_[Wrap(write_ptr_ + delay)];
+        T write = sample + coefficient * read;
+        Write(write);
+        return -write * coefficient + read;
+    }
+
+  private:
+    inline size_t Wrap(size_t i) const { return i % size_; }
+
+    T *    line_;
+    size_t size_;
+    float  frac_;
+    size_t write_ptr_;
+    size_t delay_;
+};
 } // namespace daisysp
 #endif
@@ -0,0 +1,133 @@
+#pragma once
+#ifndef DSY_DENORMAL_H
+#define DSY_DENORMAL_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define DSY_DENORMAL_SSE
+#endif
+
+namespace daisysp
+{
+/** Sets flush-to-zero (and denormals-are-zero on x86) for the current
+    thread while in scope, restoring the previous mode on exit.
+
+    Recursive structures decaying towards silence produce subnormal floats,
+    which x86 handles in microcode at a large per-operation cost. Place one
+    at the top of an audio callback:
+
+    void AudioCallback(...)
+    {
+        ScopedFlushDenormals ftz;
+        ...
+    }
+
+    A no-op on targets without a known control register.
+*/
+class ScopedFlushDenormals
+{
+  public:
+    ScopedFlushDenormals()
+    {
+#if defined(DSY_DENORMAL_SSE)
+        state_ = _mm_getcsr();
+        _mm_setcsr(state_ | 0x8040); // FTZ (bit 15) | DAZ (bit 6)
+#elif defined(__aarch64__)
+        uint64_t fpcr;
+        asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+        state_ = fpcr;
+        asm volatile("msr fpcr, %0" : : "r"(fpcr | (1ull << 24))); // FZ
+#elif defined(__arm__) && defined(__VFP_FP__) && !defined(__SOFTFP__)
+        uint32_t fpscr;
+        asm volatile("vmrs %0, fpscr" : "=r"(fpscr));
+        state_ = fpscr;
+        asm volatile("vmsr fpscr, %0" : : "r"(fpscr | (1u << 24))); // FZ
+#endif
+    }
+
+    ~ScopedFlushDenormals()
+    {
+#if defined(DSY_DENORMAL_SSE)
+        _mm_setcsr(state_);
+#elif defined(__aarch64__)
+        uint64_t fpcr = state_;
+        asm volatile("msr fpcr, %0" : : "r"(fpcr));
+#elif defined(__arm__) && defined(__VFP_FP__) && !defined(__SOFTFP__)
+        uint32_t fpscr = state_;
+        asm volatile("vmsr fpscr, %0" : : "r"(fpscr));
+#endif
+    }
+
+  private:
+    ScopedFlushDenormals(const ScopedFlushDenormals &) = delete;
+    ScopedFlushDenormals &operator=(const ScopedFlushDenormals &) = delete;
+
+#if defined(__aarch64__) && !defined(DSY_DENORMAL_SSE)
+    uint64_t state_;
+#else
+    uint32_t state_;
+#endif
+};
+
+/** Returns 0 for subnormal x, x otherwise.
+
+    Used on the feedback state of recursive modules so they stay fast on
+    hosts that do not enable flush-to-zero. Tests the exponent bits, so it
+    is not optimized away by fast-math and compiles to a compare and select.
+    Define DSY_ASSUME_FTZ when every caller runs with FTZ set to remove it.
+*/
+inline float FlushDenormal(float x)
+{
+#ifdef DSY_ASSUME_FTZ
+    return x;
+#else
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7f800000u) == 0 ? 0.0f : x;
+#endif
+}
+
+/** Double precision FlushDenormal, for modules run with T = double */
+inline double FlushDenormal(double x)
+{
+#ifdef DSY_ASSUME_FTZ
+    return x;
+#else
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7ff0000000000000ull) == 0 ? 0.0 : x;
+#endif
+}
+
+/** Returns 0 when |x| is below threshold, x otherwise.
+
+    For state that is scaled down before it is used, such as MoogLadder's
+    thermal terms. Those products go subnormal while the state itself is
+    still normal, so FlushDenormal on the state alone acts too late.
+    Removed by DSY_ASSUME_FTZ like FlushDenormal.
+*/
+inline float FlushBelow(float x, float threshold)
+{
+#ifdef DSY_ASSUME_FTZ
+    return x;
+#else
+    return x < threshold && x > -threshold ? 0.0f : x;
+#endif
+}
+
+/** Double precision FlushBelow */
+inline double FlushBelow(double x, double threshold)
+{
+#ifdef DSY_ASSUME_FTZ
+    return x;
+#else
+    return x < threshold && x > -threshold ? 0.0 : x;
+#endif
+}
+
+} // namespace daisysp
+#endif
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <random>
 #include <cmath>
+#include <cstring>
 
 /** PIs
 */
@@ -118,11 +119,67 @@ inline float fastlog10f(float f)
     return fastlog2f(f) * 0.3010299956639812f;
 }
 
+/** Fast 2 ^ x, max relative error ~1.6e-7 (about one float ulp)
+Builds 2 ^ floor(x) in the exponent bits and evaluates a 5th order
+polynomial for the fractional part. No table and no libm call, so loops
+over it vectorize. x is clamped to +/-126.
+*/
+inline float fastexp2f(float x)
+{
+    x         = fclamp(x, -126.0f, 126.0f);
+    int32_t i = (int32_t)x;
+    i -= x < (float)i ? 1 : 0;
+    const float f = x - (float)i;
+    const float p
+        = 1.0f
+          + f
+                * (0.693151295f
+                   + f
+                         * (0.240164444f
+                            + f
+                                  * (0.0557999127f
+                                     + f
+                                           * (0.00901702885f
+                                              + f * 0.00186713052f))));
+    const int32_t bits = (i + 127) << 23;
+    float         scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+/** Frequency ratio of an interval in semitones, 2 ^ (semitones / 12)
+*/
+inline float SemitonesToRatio(float semitones)
+{
+    return fastexp2f(semitones * kOneTwelfth);
+}
+
+/** Branch-free sin(2 * pi * phase) for phase in [0, 1)
+Folds the phase onto a quarter period and evaluates a 9th order
+odd polynomial, max error ~4e-6. Written with min/max rather than
+branches so loops over arrays of phases vectorize.
+*/
+inline float fastsin2pi(float phase)
+{
+    float q        = 0.5f - phase;
+    q              = fmax(fmin(q, 0.5f - q), -0.5f - q);
+    const float x  = TWOPI_F * q;
+    const float x2 = x * x;
+    return x
+           * (1.0f
+              + x2
+                    * (-1.0f / 6.0f
+                       + x2
+                             * (1.0f / 120.0f
+                                + x2 * (-1.0f / 5040.0f
+                                        + x2 * (1.0f / 362880.0f)))));
+}
+
 /** Midi to frequency helper
 */
 inline float mtof(float m)
 {
-    return powf(2, (m - 69.0f) / 12.0f) * 440.0f;
+    return SemitonesToRatio(m - 69.0f) * 440.0f;
 }
 
 
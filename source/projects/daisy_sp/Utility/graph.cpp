@@ -0,0 +1,167 @@
+#ifndef DSY_NO_THREADS
+
+#include "graph.h"
+
+using namespace daisysp;
+
+void Graph::Init(ThreadPool *pool, size_t block_size)
+{
+    pool_       = pool;
+    block_size_ = block_size;
+    size_       = 0;
+    prepared_   = false;
+    nodes_.clear();
+    head_.store(0);
+    tail_.store(0);
+}
+
+int Graph::AddNode(NodeProcess process, void *context)
+{
+    Node node;
+    node.process = process;
+    node.context = context;
+    nodes_.push_back(node);
+    prepared_ = false;
+    return (int)nodes_.size() - 1;
+}
+
+bool Graph::Connect(int from, int to)
+{
+    const int num_nodes = (int)nodes_.size();
+    if(from < 0 || from >= num_nodes || to < 0 || to >= num_nodes)
+    {
+        return false;
+    }
+    nodes_[from].successors.push_back(to);
+    nodes_[to].sources.push_back(from);
+    prepared_ = false;
+    return true;
+}
+
+bool Graph::Prepare()
+{
+    const size_t num_nodes   = nodes_.size();
+    const size_t num_threads = pool_ ? pool_->GetNumThreads() : 1;
+    outputs_.assign(num_nodes * block_size_, 0.0f);
+    scratch_.assign((num_threads > 0 ? num_threads : 1) * block_size_, 0.0f);
+    pending_.reset(new std::atomic<int>[num_nodes]);
+    slots_.reset(new std::atomic<int>[num_nodes]);
+
+    for(size_t i = 0; i < num_nodes; i++)
+    {
+        Node &node = nodes_[i];
+        node.inputs.clear();
+        for(size_t j = 0; j < node.sources.size(); j++)
+        {
+            node.inputs.push_back(&outputs_[node.sources[j] * block_size_]);
+        }
+    }
+
+    // Kahn's algorithm, every node must be reachable from a source
+    std::vector<int> remaining(num_nodes), order;
+    for(size_t i = 0; i < num_nodes; i++)
+    {
+        remaining[i] = (int)nodes_[i].sources.size();
+        if(remaining[i] == 0)
+        {
+            order.push_back((int)i);
+        }
+    }
+    for(size_t k = 0; k < order.size(); k++)
+    {
+        const std::vector<int> &next = nodes_[order[k]].successors;
+        for(size_t j = 0; j < next.size(); j++)
+        {
+            if(--remaining[next[j]] == 0)
+            {
+                order.push_back(next[j]);
+            }
+        }
+    }
+    prepared_ = order.size() == num_nodes;
+    return prepared_;
+}
+
+void Graph::Process(size_t size)
+{
+    if(!prepared_ || nodes_.empty())
+    {
+        return;
+    }
+    size_ = size < block_size_ ? size : block_size_;
+
+    const size_t num_nodes = nodes_.size();
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    for(size_t i = 0; i < num_nodes; i++)
+    {
+        pending_[i].store((int)nodes_[i].sources.size(),
+                          std::memory_order_relaxed);
+        slots_[i].store(-1, std::memory_order_relaxed);
+    }
+    for(size_t i = 0; i < num_nodes; i++)
+    {
+        if(nodes_[i].sources.empty())
+        {
+            Publish((int)i);
+        }
+    }
+
+    if(pool_)
+    {
+        pool_->Run(&Graph::Job, this);
+    }
+    else
+    {
+        Job(this, 0);
+    }
+}
+
+void Graph::Job(void *context, size_t thread)
+{
+    Graph *      g         = static_cast<Graph *>(context);
+    const size_t num_nodes = g->nodes_.size();
+    float *      scratch   = &g->scratch_[thread * g->block_size_];
+    while(true)
+    {
+        // claim the next slot, then wait for a node to be published to it
+        const size_t slot = g->head_.fetch_add(1, std::memory_order_relaxed);
+        if(slot >= num_nodes)
+        {
+            return;
+        }
+        int      id;
+        uint32_t spins = 0;
+        while((id = g->slots_[slot].load(std::memory_order_acquire)) < 0)
+        {
+            if(++spins < 1024)
+            {
+                ThreadPool::Pause();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        Node &node = g->nodes_[id];
+        node.process(node.context,
+                     node.inputs.data(),
+                     node.inputs.size(),
+                     &g->outputs_[id * g->block_size_],
+                     scratch,
+                     g->size_);
+
+        // the last input to finish hands the successor on
+        for(size_t j = 0; j < node.successors.size(); j++)
+        {
+            const int next = node.successors[j];
+            if(g->pending_[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                g->Publish(next);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,134 @@
+#pragma once
+#ifndef DSY_GRAPH_H
+#define DSY_GRAPH_H
+
+#ifndef DSY_NO_THREADS
+
+#include <stddef.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "Utility/threadpool.h"
+
+/** @file graph.h */
+
+namespace daisysp
+{
+/**
+       @brief Headless DSP graph, rendered a block at a time on a ThreadPool
+       @date Oct 2026
+       Nodes are callbacks around any DaisySP modules, e.g. one per voice
+       chain, and edges feed the output of one node into another, e.g. 64
+       voice chains into a bus node. Each block every node runs once, as soon
+       as all of its inputs are done, on whichever thread is free. \n
+       Scheduling is lock free: every node has an atomic count of unfinished
+       inputs, and the thread that finishes its last input publishes it to
+       a slot array that idle threads claim from in order. Every node owns
+       one mono output buffer, and every thread a scratch buffer of the block
+       size that nodes may use for temporary signals. \n
+       Host only, for offline bounces and load tests, see ThreadPool.
+
+       usage:
+
+       void RenderVoice(void *context, const float *const *inputs,
+                        size_t num_inputs, float *out, float *scratch,
+                        size_t size);
+
+       Graph graph;
+       graph.Init(&pool, 256);
+       int bus = graph.AddNode(MixBus, &bus_state);
+       for(int i = 0; i < 64; i++)
+           graph.Connect(graph.AddNode(RenderVoice, &voices[i]), bus);
+       graph.Prepare();
+       ...
+       graph.Process(256);
+       const float *out = graph.GetOutput(bus);
+*/
+class Graph
+{
+  public:
+    Graph() {}
+    ~Graph() {}
+
+    /** Renders one node for a block
+        \param context given to AddNode()
+        \param inputs outputs of the nodes connected to this one
+        \param num_inputs number of inputs
+        \param out size samples to write
+        \param scratch block size samples private to the calling thread
+        \param size number of samples
+    */
+    typedef void (*NodeProcess)(void *              context,
+                                const float *const *inputs,
+                                size_t              num_inputs,
+                                float *             out,
+                                float *             scratch,
+                                size_t              size);
+
+    /** Clears the graph
+        \param pool threads to render on, nullptr renders on the caller
+        \param block_size largest size passed to Process()
+    */
+    void Init(ThreadPool *pool, size_t block_size);
+
+    /** Adds a node, returns its id */
+    int AddNode(NodeProcess process, void *context);
+
+    /** Feeds the output of node from into node to
+        \return false for an unknown node
+    */
+    bool Connect(int from, int to);
+
+    /** Sorts out the schedule and buffers after the last change to the
+        nodes or edges, call before Process().
+        \return false if the edges form a cycle
+    */
+    bool Prepare();
+
+    /** Renders every node for one block
+        \param size samples, up to the block size
+    */
+    void Process(size_t size);
+
+    /** Output of a node for the last block */
+    inline const float *GetOutput(int node) const
+    {
+        return &outputs_[node * block_size_];
+    }
+
+    inline size_t GetNumNodes() const { return nodes_.size(); }
+
+  private:
+    struct Node
+    {
+        NodeProcess                process;
+        void *                     context;
+        std::vector<int>           sources, successors;
+        std::vector<const float *> inputs; // outputs of sources
+    };
+
+    static void Job(void *context, size_t thread);
+
+    // hands a node whose inputs are all done to the next free slot
+    inline void Publish(int node)
+    {
+        const size_t slot = tail_.fetch_add(1, std::memory_order_relaxed);
+        slots_[slot].store(node, std::memory_order_release);
+    }
+
+    ThreadPool *      pool_;
+    size_t            block_size_, size_;
+    std::vector<Node> nodes_;
+    bool              prepared_;
+
+    std::vector<float> outputs_; // one block per node
+    std::vector<float> scratch_; // one block per thread
+
+    std::unique_ptr<std::atomic<int>[]> pending_; // unfinished inputs
+    std::unique_ptr<std::atomic<int>[]> slots_;   // ready nodes, -1 empty
+    std::atomic<size_t>                 head_, tail_;
+};
+
+} // namespace daisysp
+#endif
+#endif
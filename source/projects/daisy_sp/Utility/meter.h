@@ -0,0 +1,505 @@
+#pragma once
+#ifndef DSY_METER_H
+#define DSY_METER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include <string.h>
+#include "Utility/dsp.h"
+#include "Utility/denormal.h"
+#ifdef __cplusplus
+
+/** @file meter.h */
+
+namespace daisysp
+{
+/**
+       @brief Multichannel level meter: peak, true peak, RMS and loudness
+       @date Oct 2026
+       Meters every channel of a bus in one pass over each block. \n
+       Sample peak and RMS are scanned along each channel with their
+       accumulators split into lanes, so the compiler vectorizes them even
+       for a stereo bus. The peak is an integer max of the bit patterns,
+       which needs no fast-math. RMS is taken over a sliding rectangular
+       window, kept as 16 segment sums, and updates every 1/16 of the
+       window. \n
+       True peak interpolates 4x with a 48 tap polyphase FIR as in ITU-R
+       BS.1770, and loudness K-weights each channel with the BS.1770 shelf
+       and high pass. Both carry state from sample to sample, so they run
+       across the channels instead, stored structure-of-arrays. \n
+       Loudness is in LUFS, momentary over 400 ms and short-term over 3 s,
+       both updated every 100 ms. Integrated loudness is gated as in
+       BS.1770 with the relative gate applied on a 0.1 LU histogram, so it
+       needs no memory of the program length and reads within 0.05 LU. \n
+       Peaks hold until ResetPeaks(). Levels are linear, 1.0 is full scale.
+
+       usage:
+
+       Meter<8> meter;
+       meter.Init(48000.0f);
+       ...
+       meter.ProcessBlock(bus, 48); // bus[ch] holds 48 samples
+       float l = meter.GetShortTermLoudness();
+*/
+template <size_t max_channels>
+class Meter
+{
+  public:
+    Meter() {}
+    ~Meter() {}
+
+    /** Initializes the meter and clears every reading
+        \param sample_rate Audio engine sample rate
+        \param rms_window RMS window in seconds
+    */
+    void Init(float sample_rate, float rms_window = 0.3f)
+    {
+        sample_rate_  = sample_rate;
+        num_channels_ = max_channels;
+        for(size_t ch = 0; ch < max_channels; ch++)
+        {
+            weight_[ch] = 1.0f;
+        }
+        InitTruePeak();
+        InitKWeighting();
+        loudness_seg_len_ = (size_t)(0.1f * sample_rate_ + 0.5f);
+        loudness_seg_len_ = loudness_seg_len_ > 0 ? loudness_seg_len_ : 1;
+        loudness_left_    = loudness_seg_len_;
+        loudness_seg_     = 0;
+        for(size_t s = 0; s < kLoudnessSegments; s++)
+        {
+            loudness_ring_[s] = 0.0f;
+        }
+        for(size_t ch = 0; ch < max_channels; ch++)
+        {
+            ksum_[ch] = 0.0f;
+            for(int k = 0; k < 2; k++)
+            {
+                shelf_z_[k][ch] = 0.0f;
+                hpf_z_[k][ch]   = 0.0f;
+            }
+        }
+        momentary_ = short_term_ = kLoudnessFloor;
+        ResetIntegrated();
+        ResetPeaks();
+        SetRmsWindow(rms_window);
+    }
+
+    /** Sets the number of channels read by ProcessBlock
+        \param num Clamped to max_channels
+    */
+    inline void SetNumChannels(size_t num)
+    {
+        num_channels_ = num < max_channels ? num : max_channels;
+    }
+
+    /** Returns the number of channels read by ProcessBlock */
+    inline size_t GetNumChannels() const { return num_channels_; }
+
+    /** Sets the RMS window and clears the RMS readings
+        \param seconds window length, rounded to 16 equal segments
+    */
+    void SetRmsWindow(float seconds)
+    {
+        rms_seg_len_ = (size_t)(seconds * sample_rate_ / kRmsSegments + 0.5f);
+        rms_seg_len_ = rms_seg_len_ > 0 ? rms_seg_len_ : 1;
+        rms_left_    = rms_seg_len_;
+        rms_seg_     = 0;
+        for(size_t ch = 0; ch < max_channels; ch++)
+        {
+            rms_acc_[ch] = 0.0f;
+            rms_[ch]     = 0.0f;
+            for(size_t s = 0; s < kRmsSegments; s++)
+            {
+                rms_ring_[s][ch] = 0.0f;
+            }
+        }
+    }
+
+    /** Sets the loudness weight of one channel: 1.0 for left, right and
+        centre, 1.41 for the surrounds, 0.0 to leave out an LFE channel.
+    */
+    inline void SetChannelWeight(size_t ch, float weight)
+    {
+        weight_[ch] = weight;
+    }
+
+    /** Meters a block of every active channel
+        \param in one buffer of size samples per channel
+        \param size number of samples
+    */
+    void ProcessBlock(const float *const *in, size_t size)
+    {
+        size_t done = 0;
+        while(done < size)
+        {
+            // split the block where an RMS or loudness segment ends
+            size_t n = size - done;
+            n        = n < rms_left_ ? n : rms_left_;
+            n        = n < loudness_left_ ? n : loudness_left_;
+            ScanPeakRms(in, done, n);
+            ProcessTruePeakLoudness(in, done, n);
+            done += n;
+            rms_left_ -= n;
+            loudness_left_ -= n;
+            if(rms_left_ == 0)
+            {
+                EndRmsSegment();
+            }
+            if(loudness_left_ == 0)
+            {
+                EndLoudnessSegment();
+            }
+        }
+    }
+
+    /** Highest absolute sample of a channel since ResetPeaks() */
+    inline float GetPeak(size_t ch) const { return peak_[ch]; }
+
+    /** Highest absolute 4x interpolated sample of a channel since
+        ResetPeaks(), never below GetPeak()
+    */
+    inline float GetTruePeak(size_t ch) const
+    {
+        return true_peak_[ch] > peak_[ch] ? true_peak_[ch] : peak_[ch];
+    }
+
+    /** Restarts the peak and true peak hold of every channel */
+    void ResetPeaks()
+    {
+        for(size_t ch = 0; ch < max_channels; ch++)
+        {
+            peak_[ch]      = 0.0f;
+            true_peak_[ch] = 0.0f;
+        }
+    }
+
+    /** RMS of a channel over the last full window */
+    inline float GetRms(size_t ch) const { return rms_[ch]; }
+
+    /** Loudness of the last 400 ms in LUFS */
+    inline float GetMomentaryLoudness() const { return momentary_; }
+
+    /** Loudness of the last 3 s in LUFS */
+    inline float GetShortTermLoudness() const { return short_term_; }
+
+    /** Gated loudness since Init() or ResetIntegrated() in LUFS. Scans a
+        histogram, so call it from the UI rather than per block.
+    */
+    float GetIntegratedLoudness() const
+    {
+        // absolute gate: the histogram only holds blocks above -70 LUFS
+        uint32_t count  = 0;
+        double   energy = 0.0;
+        for(size_t b = 0; b < kHistogramBins; b++)
+        {
+            count += histogram_[b];
+            energy += histogram_[b] * BinEnergy(b);
+        }
+        if(count == 0)
+        {
+            return kLoudnessFloor;
+        }
+
+        // relative gate, 10 LU below the loudness of the blocks above
+        const float  gate  = EnergyToLoudness(energy / count) - 10.0f;
+        const size_t first = LoudnessToBin(gate) + 1;
+        count              = 0;
+        energy             = 0.0;
+        for(size_t b = first; b < kHistogramBins; b++)
+        {
+            count += histogram_[b];
+            energy += histogram_[b] * BinEnergy(b);
+        }
+        return count > 0 ? EnergyToLoudness(energy / count) : kLoudnessFloor;
+    }
+
+    /** Restarts the integrated loudness measurement */
+    void ResetIntegrated()
+    {
+        for(size_t b = 0; b < kHistogramBins; b++)
+        {
+            histogram_[b] = 0;
+        }
+        gating_segments_ = 0;
+    }
+
+  private:
+    static constexpr size_t kLanes            = 8;
+    static constexpr size_t kRmsSegments      = 16;
+    static constexpr size_t kLoudnessSegments = 30; // 3 s of 100 ms
+    static constexpr size_t kPhases           = 4;
+    static constexpr size_t kTaps             = 12; // per phase
+    static constexpr size_t kHistogramBins    = 800; // -70 to +10 LUFS
+    static constexpr float  kLoudnessFloor    = -120.0f;
+
+    static inline float EnergyToLoudness(double energy)
+    {
+        return energy > 1.0e-12 ? -0.691f + 10.0f * (float)log10(energy)
+                                : kLoudnessFloor;
+    }
+
+    static inline size_t LoudnessToBin(float loudness)
+    {
+        const float b = (loudness + 70.0f) * 10.0f;
+        return b <= 0.0f ? 0
+               : b < kHistogramBins ? (size_t)b
+                                    : kHistogramBins - 1;
+    }
+
+    // mean square at the centre of a histogram bin
+    static inline double BinEnergy(size_t b)
+    {
+        return pow(10.0, ((b + 0.5) * 0.1 - 70.0 + 0.691) * 0.1);
+    }
+
+    // windowed sinc split into 4 phases, each normalized to unity gain
+    void InitTruePeak()
+    {
+        const double pi  = 3.14159265358979323846;
+        const size_t len = kPhases * kTaps;
+        for(size_t p = 0; p < kPhases; p++)
+        {
+            float sum = 0.0f;
+            for(size_t k = 0; k < kTaps; k++)
+            {
+                const size_t i = k * kPhases + p;
+                const double t = (i - (len - 1) * 0.5) / kPhases;
+                const double w = 0.42 - 0.5 * cos(2.0 * pi * (i + 0.5) / len)
+                                 + 0.08 * cos(4.0 * pi * (i + 0.5) / len);
+                const double s = sin(pi * t) / (pi * t);
+                tp_coef_[p][k] = (float)(s * w);
+                sum += tp_coef_[p][k];
+            }
+            for(size_t k = 0; k < kTaps; k++)
+            {
+                tp_coef_[p][k] /= sum;
+            }
+        }
+        tp_pos_ = 0;
+        for(size_t k = 0; k < 2 * kTaps; k++)
+        {
+            for(size_t ch = 0; ch < max_channels; ch++)
+            {
+                tp_hist_[k][ch] = 0.0f;
+            }
+        }
+    }
+
+    // BS.1770 pre-filter, redesigned for the sample rate
+    void InitKWeighting()
+    {
+        const double pi = 3.14159265358979323846;
+        double       f0 = 1681.974450955533, q = 0.7071752369554196;
+        double       k  = tan(pi * f0 / sample_rate_);
+        const double vh = pow(10.0, 3.999843853973347 / 20.0);
+        const double vb = pow(vh, 0.4996667741545416);
+        double       a0 = 1.0 + k / q + k * k;
+        shelf_b_[0]     = (float)((vh + vb * k / q + k * k) / a0);
+        shelf_b_[1]     = (float)(2.0 * (k * k - vh) / a0);
+        shelf_b_[2]     = (float)((vh - vb * k / q + k * k) / a0);
+        shelf_a_[0]     = (float)(2.0 * (k * k - 1.0) / a0);
+        shelf_a_[1]     = (float)((1.0 - k / q + k * k) / a0);
+
+        f0        = 38.13547087602444;
+        q         = 0.5003270373238773;
+        k         = tan(pi * f0 / sample_rate_);
+        a0        = 1.0 + k / q + k * k;
+        hpf_a_[0] = (float)(2.0 * (k * k - 1.0) / a0);
+        hpf_a_[1] = (float)((1.0 - k / q + k * k) / a0);
+    }
+
+    // |x| as its bit pattern, which orders like the float but takes an
+    // integer max, so the scan vectorizes without fast-math
+    static inline uint32_t AbsBits(float x)
+    {
+        uint32_t bits;
+        memcpy(&bits, &x, sizeof(bits));
+        return bits & 0x7fffffff;
+    }
+
+    void ScanPeakRms(const float *const *in, size_t offset, size_t size)
+    {
+        for(size_t ch = 0; ch < num_channels_; ch++)
+        {
+            const float *x = in[ch] + offset;
+            uint32_t     peak[kLanes];
+            float        sum[kLanes];
+            for(size_t j = 0; j < kLanes; j++)
+            {
+                peak[j] = 0;
+                sum[j]  = 0.0f;
+            }
+            size_t i = 0;
+            for(; i + kLanes <= size; i += kLanes)
+            {
+                for(size_t j = 0; j < kLanes; j++)
+                {
+                    const uint32_t a = AbsBits(x[i + j]);
+                    peak[j]          = a > peak[j] ? a : peak[j];
+                    sum[j] += x[i + j] * x[i + j];
+                }
+            }
+            for(; i < size; i++)
+            {
+                const uint32_t a = AbsBits(x[i]);
+                peak[0]          = a > peak[0] ? a : peak[0];
+                sum[0] += x[i] * x[i];
+            }
+            uint32_t max = AbsBits(peak_[ch]);
+            for(size_t j = 0; j < kLanes; j++)
+            {
+                max = peak[j] > max ? peak[j] : max;
+                rms_acc_[ch] += sum[j];
+            }
+            memcpy(&peak_[ch], &max, sizeof(max));
+        }
+    }
+
+    void ProcessTruePeakLoudness(const float *const *in,
+                                 size_t              offset,
+                                 size_t              size)
+    {
+        const size_t nch = num_channels_;
+        float        x[max_channels], y[max_channels];
+        for(size_t i = 0; i < size; i++)
+        {
+            // newest sample at tp_pos_, mirrored kTaps on so the taps are
+            // always contiguous
+            const size_t pos = tp_pos_;
+            for(size_t ch = 0; ch < nch; ch++)
+            {
+                x[ch]                     = in[ch][offset + i];
+                tp_hist_[pos][ch]         = x[ch];
+                tp_hist_[pos + kTaps][ch] = x[ch];
+            }
+            tp_pos_ = pos > 0 ? pos - 1 : kTaps - 1;
+
+            for(size_t p = 0; p < kPhases; p++)
+            {
+                for(size_t ch = 0; ch < nch; ch++)
+                {
+                    y[ch] = 0.0f;
+                }
+                for(size_t k = 0; k < kTaps; k++)
+                {
+                    const float  c = tp_coef_[p][k];
+                    const float *h = tp_hist_[pos + k];
+                    for(size_t ch = 0; ch < nch; ch++)
+                    {
+                        y[ch] += c * h[ch];
+                    }
+                }
+                for(size_t ch = 0; ch < nch; ch++)
+                {
+                    const float a  = fabsf(y[ch]);
+                    true_peak_[ch] = a > true_peak_[ch] ? a : true_peak_[ch];
+                }
+            }
+
+            // K-weighting, shelf then high pass, transposed direct form II
+            for(size_t ch = 0; ch < nch; ch++)
+            {
+                const float s   = shelf_b_[0] * x[ch] + shelf_z_[0][ch];
+                shelf_z_[0][ch] = shelf_b_[1] * x[ch] - shelf_a_[0] * s
+                                  + shelf_z_[1][ch];
+                shelf_z_[1][ch] = shelf_b_[2] * x[ch] - shelf_a_[1] * s;
+
+                const float h = s + hpf_z_[0][ch];
+                hpf_z_[0][ch] = -2.0f * s - hpf_a_[0] * h + hpf_z_[1][ch];
+                hpf_z_[1][ch] = s - hpf_a_[1] * h;
+                ksum_[ch] += h * h;
+            }
+        }
+    }
+
+    void EndRmsSegment()
+    {
+        rms_left_ = rms_seg_len_;
+        const float scale = 1.0f / (kRmsSegments * rms_seg_len_);
+        for(size_t ch = 0; ch < num_channels_; ch++)
+        {
+            rms_ring_[rms_seg_][ch] = rms_acc_[ch];
+            rms_acc_[ch]            = 0.0f;
+        }
+        for(size_t ch = 0; ch < num_channels_; ch++)
+        {
+            float sum = 0.0f;
+            for(size_t s = 0; s < kRmsSegments; s++)
+            {
+                sum += rms_ring_[s][ch];
+            }
+            rms_[ch] = sqrtf(sum * scale);
+        }
+        rms_seg_ = (rms_seg_ + 1) % kRmsSegments;
+    }
+
+    void EndLoudnessSegment()
+    {
+        loudness_left_ = loudness_seg_len_;
+        float energy   = 0.0f;
+        for(size_t ch = 0; ch < num_channels_; ch++)
+        {
+            energy += weight_[ch] * ksum_[ch];
+            ksum_[ch] = 0.0f;
+            for(int k = 0; k < 2; k++)
+            {
+                shelf_z_[k][ch] = FlushDenormal(shelf_z_[k][ch]);
+                hpf_z_[k][ch]   = FlushDenormal(hpf_z_[k][ch]);
+            }
+        }
+        loudness_ring_[loudness_seg_] = energy / loudness_seg_len_;
+        loudness_seg_ = (loudness_seg_ + 1) % kLoudnessSegments;
+
+        // the newest 4 segments make the momentary block
+        double momentary = 0.0, short_term = 0.0;
+        for(size_t s = 0; s < kLoudnessSegments; s++)
+        {
+            const size_t age = (loudness_seg_ + kLoudnessSegments - 1 - s)
+                               % kLoudnessSegments;
+            momentary += age < 4 ? loudness_ring_[s] : 0.0f;
+            short_term += loudness_ring_[s];
+        }
+        momentary_  = EnergyToLoudness(momentary / 4);
+        short_term_ = EnergyToLoudness(short_term / kLoudnessSegments);
+
+        // gating blocks are the momentary blocks, overlapping by 75%
+        if(gating_segments_ < 4)
+        {
+            gating_segments_++;
+        }
+        if(gating_segments_ == 4 && momentary_ > -70.0f)
+        {
+            histogram_[LoudnessToBin(momentary_)]++;
+        }
+    }
+
+    float  sample_rate_;
+    size_t num_channels_;
+    float  weight_[max_channels];
+
+    // peak, true peak and RMS per channel
+    float  peak_[max_channels], true_peak_[max_channels];
+    float  rms_acc_[max_channels], rms_[max_channels];
+    float  rms_ring_[kRmsSegments][max_channels];
+    size_t rms_seg_len_, rms_left_, rms_seg_;
+
+    float  tp_coef_[kPhases][kTaps];
+    float  tp_hist_[2 * kTaps][max_channels];
+    size_t tp_pos_;
+
+    // loudness
+    float    shelf_b_[3], shelf_a_[2], hpf_a_[2];
+    float    shelf_z_[2][max_channels], hpf_z_[2][max_channels];
+    float    ksum_[max_channels];
+    float    loudness_ring_[kLoudnessSegments];
+    size_t   loudness_seg_len_, loudness_left_, loudness_seg_;
+    float    momentary_, short_term_;
+    uint32_t histogram_[kHistogramBins];
+    size_t   gating_segments_;
+};
+
+} // namespace daisysp
+#endif
+#endif
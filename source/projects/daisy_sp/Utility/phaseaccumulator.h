@@ -0,0 +1,110 @@
+#pragma once
+#ifndef DSY_PHASEACCUMULATOR_H
+#define DSY_PHASEACCUMULATOR_H
+
+#include <stdint.h>
+#include <math.h>
+#ifdef __cplusplus
+
+/** @file phaseaccumulator.h */
+
+namespace daisysp
+{
+/** 32-bit fixed-point phase, one cycle is 2^32, as in SquareNoise.
+
+    Adding the increment wraps by integer overflow, with no compare and
+    no branch. Resolution is the same at any frequency, unlike a float
+    phase that loses bits as it nears 1.0. Negative increments work the
+    same way. \n
+    The free functions below convert and index raw uint32_t phases, for
+    modules that keep phases in arrays across voices or lanes. All of
+    them are branch-free and vectorize.
+*/
+
+/** Largest float below 2^32, keeps a fraction that rounds to 1.0 in range */
+static constexpr float kPhaseScale = 4294967040.0f;
+
+/** Converts a phase or increment in cycles, any sign or size, to fixed point */
+inline uint32_t PhaseFromFloat(float cycles)
+{
+    return static_cast<uint32_t>((cycles - floorf(cycles)) * kPhaseScale);
+}
+
+/** Returns a fixed-point phase as 0.0 to 1.0, exclusive, with 24 bits */
+inline float PhaseToFloat(uint32_t phase)
+{
+    // signed 24 bit conversion, a single instruction on every target
+    return static_cast<float>(static_cast<int32_t>(phase >> 8))
+           * (1.0f / 16777216.0f);
+}
+
+/** Index into a table of 2^bits points */
+template <int bits>
+inline uint32_t PhaseIndex(uint32_t phase)
+{
+    return phase >> (32 - bits);
+}
+
+/** Position between PhaseIndex and the next point, 0.0 to 1.0 */
+template <int bits>
+inline float PhaseFraction(uint32_t phase)
+{
+    return PhaseToFloat(phase << bits);
+}
+
+/** Scalar phase accumulator over a fixed-point phase */
+class PhaseAccumulator
+{
+  public:
+    PhaseAccumulator() {}
+    ~PhaseAccumulator() {}
+
+    /** Starts at phase 0 with no increment */
+    inline void Init()
+    {
+        phase_     = 0;
+        increment_ = 0;
+    }
+
+    /** Sets the increment
+        \param cycles cycles per sample, e.g. freq / sample_rate
+    */
+    inline void SetIncrement(float cycles)
+    {
+        increment_ = PhaseFromFloat(cycles);
+    }
+
+    /** Advances by one increment
+        \return true if the phase wrapped, past the end of the cycle for a
+        positive increment or back past the start for a negative one
+    */
+    inline bool Advance()
+    {
+        const uint32_t previous = phase_;
+        phase_ += increment_;
+        return static_cast<int32_t>(increment_) < 0 ? phase_ > previous
+                                                    : phase_ < previous;
+    }
+
+    /** Adds an offset in cycles, e.g. for phase modulation */
+    inline void Add(float cycles) { phase_ += PhaseFromFloat(cycles); }
+
+    /** Sets the phase in cycles, wrapped to 0.0 to 1.0 */
+    inline void Reset(float phase = 0.0f) { phase_ = PhaseFromFloat(phase); }
+
+    /** Returns the phase, 0.0 to 1.0 exclusive */
+    inline float GetPhase() const { return PhaseToFloat(phase_); }
+
+    /** Returns the fixed-point phase */
+    inline uint32_t GetRaw() const { return phase_; }
+
+    /** Returns true in the first half of the cycle */
+    inline bool IsFirstHalf() const { return phase_ < 0x80000000u; }
+
+  private:
+    uint32_t phase_, increment_;
+};
+
+} // namespace daisysp
+#endif
+#endif
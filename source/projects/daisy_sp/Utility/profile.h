@@ -0,0 +1,138 @@
+#pragma once
+#ifndef DSY_PROFILE_H
+#define DSY_PROFILE_H
+
+#ifdef DSY_PROFILE
+
+#include <stdint.h>
+#include <atomic>
+#include "Utility/cyclestats.h"
+
+namespace daisysp
+{
+/** Call and cycle count for one instrumented code path.
+
+    Counters are created by DSY_PROFILE_SCOPE as function statics and link
+    themselves into a global list on first use, without locks. A host walks
+    the list to dump them:
+
+    for(const ProfileCounter *c = ProfileCounter::GetFirst(); c;
+        c = c->GetNext())
+    {
+        printf("%s %llu calls %llu cycles\n", c->GetName(), ...);
+    }
+
+    Cycles are ReadCycleCounter ticks and include nested scopes. A scope in
+    a class template counts each instantiation separately, so one name may
+    appear several times. Only declared when DSY_PROFILE is defined.
+*/
+class ProfileCounter
+{
+  public:
+    explicit ProfileCounter(const char *name)
+    : name_(name), calls_(0), cycles_(0), next_(nullptr)
+    {
+        std::atomic<ProfileCounter *> &head = Head();
+        ProfileCounter *first = head.load(std::memory_order_relaxed);
+        do
+        {
+            next_ = first;
+        } while(!head.compare_exchange_weak(
+            first, this, std::memory_order_release, std::memory_order_relaxed));
+    }
+    ~ProfileCounter() {}
+
+    /** Adds one call taking cycles ticks, safe from any thread */
+    inline void Add(uint64_t cycles)
+    {
+        calls_.fetch_add(1, std::memory_order_relaxed);
+        cycles_.fetch_add(cycles, std::memory_order_relaxed);
+    }
+
+    /** Zeroes this counter */
+    void Reset()
+    {
+        calls_.store(0, std::memory_order_relaxed);
+        cycles_.store(0, std::memory_order_relaxed);
+    }
+
+    const char *GetName() const { return name_; }
+    uint64_t    GetCalls() const { return calls_.load(std::memory_order_relaxed); }
+    uint64_t GetCycles() const { return cycles_.load(std::memory_order_relaxed); }
+
+    /** Next counter in the registry, or nullptr */
+    const ProfileCounter *GetNext() const { return next_; }
+
+    /** Most recently registered counter, or nullptr if none has run yet */
+    static const ProfileCounter *GetFirst()
+    {
+        return Head().load(std::memory_order_acquire);
+    }
+
+    /** Zeroes every registered counter */
+    static void ResetAll()
+    {
+        for(ProfileCounter *c = Head().load(std::memory_order_acquire); c;
+            c = c->next_)
+        {
+            c->Reset();
+        }
+    }
+
+  private:
+    ProfileCounter(const ProfileCounter &) = delete;
+    ProfileCounter &operator=(const ProfileCounter &) = delete;
+
+    static std::atomic<ProfileCounter *> &Head()
+    {
+        static std::atomic<ProfileCounter *> head(nullptr);
+        return head;
+    }
+
+    const char           *name_;
+    std::atomic<uint64_t> calls_, cycles_;
+    ProfileCounter       *next_;
+};
+
+/** Adds its own lifetime to a ProfileCounter */
+class ProfileScope
+{
+  public:
+    explicit ProfileScope(ProfileCounter &counter)
+    : counter_(counter), start_(ReadCycleCounter())
+    {
+    }
+    ~ProfileScope() { counter_.Add(ReadCycleCounter() - start_); }
+
+  private:
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+    ProfileCounter &counter_;
+    uint64_t        start_;
+};
+
+} // namespace daisysp
+
+#define DSY_PROFILE_CONCAT_(a, b) a##b
+#define DSY_PROFILE_CONCAT(a, b) DSY_PROFILE_CONCAT_(a, b)
+
+/** Counts calls to, and cycles spent in, the rest of the enclosing block.
+    Compiles to nothing unless DSY_PROFILE is defined, and without it this
+    header declares nothing else, so modules can include it at no cost.
+    \param name string literal, by convention "Class::Function"
+*/
+#define DSY_PROFILE_SCOPE(name)                                      \
+    static ::daisysp::ProfileCounter DSY_PROFILE_CONCAT(             \
+        dsy_profile_counter_, __LINE__)(name);                       \
+    ::daisysp::ProfileScope DSY_PROFILE_CONCAT(dsy_profile_scope_,   \
+                                               __LINE__)(            \
+        DSY_PROFILE_CONCAT(dsy_profile_counter_, __LINE__))
+
+#else
+
+#define DSY_PROFILE_SCOPE(name)
+
+#endif
+
+#endif
@@ -0,0 +1,154 @@
+#pragma once
+#ifndef DSY_RINGBUFFER_H
+#define DSY_RINGBUFFER_H
+
+#include <stddef.h>
+#include <atomic>
+#ifdef __cplusplus
+
+/** @file ringbuffer.h */
+
+namespace daisysp
+{
+/**
+       @brief Wait-free single-producer, single-consumer FIFO
+       @date Oct 2026
+       Moves audio or any other trivially copyable T between exactly two
+       threads, e.g. the audio callback and a disk or analysis thread. Push
+       and Pop never block, loop or allocate: they move as much as fits and
+       return the count. \n
+       The storage is a member array of max_size, a power of two, so the
+       indices wrap with a mask. Each side only writes its own index, and
+       the two indices and the data sit on separate cache lines so the
+       threads do not invalidate each other's lines on every call. Each side
+       also keeps a copy of the other side's index, refreshed only when the
+       copy says the ring is full or empty.
+
+       declaration example: (about 1 second of floats)
+
+       RingBuffer<float, 65536> ring;
+*/
+template <typename T, size_t max_size>
+class RingBuffer
+{
+    static_assert(max_size >= 2 && (max_size & (max_size - 1)) == 0,
+                  "max_size must be a power of two");
+
+  public:
+    RingBuffer() {}
+    ~RingBuffer() {}
+
+    /** Empties the ring. Not thread safe, call before either side starts. */
+    void Init()
+    {
+        write_.store(0, std::memory_order_relaxed);
+        read_.store(0, std::memory_order_relaxed);
+        write_cache_ = 0;
+        read_cache_  = 0;
+    }
+
+    /** Producer: copies up to size items in
+        \return number of items written, less than size if the ring filled
+    */
+    size_t Push(const T *data, size_t size)
+    {
+        const size_t write = write_.load(std::memory_order_relaxed);
+        size_t       space = max_size - (write - read_cache_);
+        if(space < size)
+        {
+            read_cache_ = read_.load(std::memory_order_acquire);
+            space       = max_size - (write - read_cache_);
+        }
+        size = size < space ? size : space;
+        CopyIn(data, write & kMask, size);
+        write_.store(write + size, std::memory_order_release);
+        return size;
+    }
+
+    /** Producer: writes one item
+        \return false if the ring is full
+    */
+    inline bool Push(const T &item) { return Push(&item, 1) == 1; }
+
+    /** Consumer: copies up to size items out
+        \return number of items read, less than size if the ring emptied
+    */
+    size_t Pop(T *data, size_t size)
+    {
+        const size_t read      = read_.load(std::memory_order_relaxed);
+        size_t       available = write_cache_ - read;
+        if(available < size)
+        {
+            write_cache_ = write_.load(std::memory_order_acquire);
+            available    = write_cache_ - read;
+        }
+        size = size < available ? size : available;
+        CopyOut(read & kMask, data, size);
+        read_.store(read + size, std::memory_order_release);
+        return size;
+    }
+
+    /** Consumer: reads one item
+        \return false if the ring is empty
+    */
+    inline bool Pop(T &item) { return Pop(&item, 1) == 1; }
+
+    /** Items waiting to be read, exact from the consumer */
+    inline size_t GetReadable() const
+    {
+        return write_.load(std::memory_order_acquire)
+               - read_.load(std::memory_order_relaxed);
+    }
+
+    /** Free space, exact from the producer */
+    inline size_t GetWritable() const
+    {
+        return max_size
+               - (write_.load(std::memory_order_relaxed)
+                  - read_.load(std::memory_order_acquire));
+    }
+
+    static constexpr size_t GetCapacity() { return max_size; }
+
+  private:
+    static constexpr size_t kMask      = max_size - 1;
+    static constexpr size_t kCacheLine = 64;
+
+    // copy size items to or from the ring at index, in at most two runs
+    void CopyIn(const T *src, size_t index, size_t size)
+    {
+        const size_t first = size < max_size - index ? size : max_size - index;
+        for(size_t i = 0; i < first; i++)
+        {
+            buff_[index + i] = src[i];
+        }
+        for(size_t i = first; i < size; i++)
+        {
+            buff_[i - first] = src[i];
+        }
+    }
+
+    void CopyOut(size_t index, T *dst, size_t size) const
+    {
+        const size_t first = size < max_size - index ? size : max_size - index;
+        for(size_t i = 0; i < first; i++)
+        {
+            dst[i] = buff_[index + i];
+        }
+        for(size_t i = first; i < size; i++)
+        {
+            dst[i] = buff_[i - first];
+        }
+    }
+
+    // free running indices, only their difference is meaningful
+    alignas(kCacheLine) std::atomic<size_t> write_;
+    size_t read_cache_; // producer's copy of read_
+    alignas(kCacheLine) std::atomic<size_t> read_;
+    size_t write_cache_; // consumer's copy of write_
+    alignas(kCacheLine) T buff_[max_size];
+};
+
+} // namespace daisysp
+#endif
+#endif
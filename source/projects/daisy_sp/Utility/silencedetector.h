@@ -0,0 +1,106 @@
+#pragma once
+#ifndef DSY_SILENCEDETECTOR_H
+#define DSY_SILENCEDETECTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#ifdef __cplusplus
+
+/** @file silencedetector.h */
+
+namespace daisysp
+{
+/**
+       @brief Tracks whether a signal has decayed below audibility
+       @date Oct 2026
+       Counts the samples since the signal last reached the threshold, and
+       reports silence once that count exceeds the hold time. The hold time
+       bridges zero crossings and slow low frequency swings, so a decaying
+       kick is not reported silent between its cycles. \n
+       Decaying modules feed their output (and input, for effects) through
+       one of these and expose IsSilent(), letting a host skip or zero-fill
+       them once idle. Process costs a compare per sample, ProcessBlock a
+       peak scan per block. \n
+       A new detector, and one after Init, reports silence.
+*/
+class SilenceDetector
+{
+  public:
+    SilenceDetector() {}
+    ~SilenceDetector() {}
+
+    /** Initializes the detector in the silent state
+        \param sample_rate Audio engine sample rate
+        \param hold_time seconds below threshold before reporting silence
+        \param threshold absolute level, 1e-4 (-80 dBFS) by default
+    */
+    void Init(float sample_rate,
+              float hold_time = 0.05f,
+              float threshold = 1.0e-4f)
+    {
+        sample_rate_ = sample_rate;
+        threshold_   = threshold;
+        SetHoldTime(hold_time);
+        quiet_ = hold_;
+    }
+
+    /** Tracks one sample
+        \param in signal to track
+    */
+    inline void Process(float in)
+    {
+        quiet_ = fabsf(in) < threshold_ ? (quiet_ < hold_ ? quiet_ + 1 : hold_)
+                                        : 0;
+    }
+
+    /** Tracks a block by its peak level
+        \param in size samples
+        \param size number of samples
+    */
+    void ProcessBlock(const float *in, size_t size)
+    {
+        float peak = 0.0f;
+        for(size_t i = 0; i < size; i++)
+        {
+            const float a = fabsf(in[i]);
+            peak          = a > peak ? a : peak;
+        }
+        Skip(peak < threshold_ ? size : 0);
+    }
+
+    /** Accounts for a block known to be silent without scanning it, e.g.
+        one the host zero-filled. A size of 0 marks the signal as audible.
+    */
+    inline void Skip(size_t size)
+    {
+        quiet_ = size == 0 ? 0
+                 : quiet_ + size < hold_ ? quiet_ + (uint32_t)size
+                                         : hold_;
+    }
+
+    /** Marks the signal as audible, e.g. on a trigger */
+    inline void Reset() { quiet_ = 0; }
+
+    /** True once the signal has stayed below threshold for the hold time */
+    inline bool IsSilent() const { return quiet_ >= hold_; }
+
+    /** Level below which a sample counts as silent */
+    inline void SetThreshold(float threshold) { threshold_ = threshold; }
+
+    /** Seconds the signal must stay below threshold */
+    inline void SetHoldTime(float hold_time)
+    {
+        hold_  = (uint32_t)(hold_time * sample_rate_);
+        hold_  = hold_ > 0 ? hold_ : 1;
+        quiet_ = quiet_ < hold_ ? quiet_ : hold_;
+    }
+
+  private:
+    float    sample_rate_, threshold_;
+    uint32_t quiet_, hold_;
+};
+
+} // namespace daisysp
+#endif
+#endif
@@ -0,0 +1,115 @@
+#ifndef DSY_NO_THREADS
+
+#include "threadpool.h"
+
+using namespace daisysp;
+
+void ThreadPool::Init(size_t num_threads)
+{
+    Shutdown();
+    if(num_threads == 0)
+    {
+        num_threads = std::thread::hardware_concurrency();
+        num_threads = num_threads > 0 ? num_threads : 1;
+    }
+    num_threads_ = num_threads;
+    job_         = nullptr;
+    context_     = nullptr;
+    generation_.store(0);
+    running_.store(0);
+    parked_.store(0);
+    quit_.store(false);
+    for(size_t i = 1; i < num_threads_; i++)
+    {
+        workers_.emplace_back(&ThreadPool::Worker, this, i);
+    }
+}
+
+void ThreadPool::Run(Job job, void *context)
+{
+    if(workers_.empty())
+    {
+        job(context, 0);
+        return;
+    }
+    job_     = job;
+    context_ = context;
+    running_.store(workers_.size(), std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_seq_cst);
+
+    // a worker increments parked_ before it checks generation_ under the
+    // mutex, so either it sees the new generation or we see it parked
+    if(parked_.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_.notify_all();
+    }
+
+    job(context, 0);
+
+    uint32_t spins = 0;
+    while(running_.load(std::memory_order_acquire) > 0)
+    {
+        if(++spins < kSpinCount)
+        {
+            Pause();
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::Shutdown()
+{
+    if(workers_.empty())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_.store(true);
+        generation_.fetch_add(1);
+    }
+    wake_.notify_all();
+    for(size_t i = 0; i < workers_.size(); i++)
+    {
+        workers_[i].join();
+    }
+    workers_.clear();
+    num_threads_ = 0;
+}
+
+void ThreadPool::Worker(size_t thread)
+{
+    uint32_t seen = 0;
+    while(true)
+    {
+        // spin briefly, then park until the next Run() or Shutdown()
+        uint32_t spins = 0;
+        while(generation_.load(std::memory_order_acquire) == seen
+              && ++spins < kSpinCount)
+        {
+            Pause();
+        }
+        if(generation_.load(std::memory_order_acquire) == seen)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            parked_.fetch_add(1, std::memory_order_seq_cst);
+            wake_.wait(lock, [&] {
+                return generation_.load(std::memory_order_seq_cst) != seen;
+            });
+            parked_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        seen = generation_.load(std::memory_order_acquire);
+        if(quit_.load())
+        {
+            return;
+        }
+        job_(context_, thread);
+        running_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef DSY_THREADPOOL_H
+#define DSY_THREADPOOL_H
+
+#ifndef DSY_NO_THREADS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** @file threadpool.h */
+
+namespace daisysp
+{
+/**
+       @brief Fixed set of worker threads for rendering blocks on every core
+       @date Oct 2026
+       Run() calls a job on every thread of the pool, the calling thread
+       included as thread 0, and returns once they have all returned. Jobs
+       share their work out themselves, e.g. through atomic counters, as
+       Graph does. \n
+       Between jobs the workers spin for a short while, so back to back
+       blocks start without a system call, and then park on a condition
+       variable so an idle pool costs nothing. The mutex is only taken to
+       park and to wake parked workers, never while a job runs, so a
+       realtime caller cannot be blocked behind a descheduled worker. \n
+       Host only, it needs std::thread. Define DSY_NO_THREADS to compile it
+       out on targets without threads.
+*/
+class ThreadPool
+{
+  public:
+    ThreadPool() : num_threads_(0) {}
+    ~ThreadPool() { Shutdown(); }
+
+    /** Job run on each thread
+        \param context passed through from Run()
+        \param thread 0 to GetNumThreads() - 1, 0 is the caller of Run()
+    */
+    typedef void (*Job)(void *context, size_t thread);
+
+    /** Starts the workers
+        \param num_threads threads including the caller, 0 for one per core
+    */
+    void Init(size_t num_threads = 0);
+
+    /** Runs job on every thread and returns when all have finished.
+        Call from one thread at a time.
+    */
+    void Run(Job job, void *context);
+
+    /** Stops and joins the workers, also done by the destructor */
+    void Shutdown();
+
+    /** Threads taking part in a Run(), the caller included */
+    inline size_t GetNumThreads() const { return num_threads_; }
+
+    /** Busy-wait hint for spin loops */
+    static inline void Pause()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+        asm volatile("yield");
+#endif
+    }
+
+  private:
+    // spins before a worker parks, roughly 10 to 50 us
+    static constexpr uint32_t kSpinCount = 4096;
+
+    void Worker(size_t thread);
+
+    std::vector<std::thread> workers_;
+    size_t                   num_threads_;
+
+    Job   job_;
+    void *context_;
+
+    std::atomic<uint32_t> generation_; // bumped by each Run()
+    std::atomic<size_t>   running_;    // workers still in the current job
+    std::atomic<size_t>   parked_;     // workers waiting on wake_
+    std::atomic<bool>     quit_;
+
+    std::mutex              mutex_;
+    std::condition_variable wake_;
+};
+
+} // namespace daisysp
+#endif
+#endif
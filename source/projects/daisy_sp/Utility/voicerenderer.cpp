@@ -0,0 +1,163 @@
+#ifndef DSY_NO_THREADS
+
+#include "voicerenderer.h"
+#include "cyclestats.h"
+
+using namespace daisysp;
+
+void VoiceRenderer::Init(ThreadPool *pool, size_t block_size)
+{
+    pool_        = pool;
+    num_threads_ = pool ? pool->GetNumThreads() : 1;
+    num_threads_ = num_threads_ > 0 ? num_threads_ : 1;
+    block_size_  = block_size;
+    size_        = 0;
+    render_      = nullptr;
+    voices_      = nullptr;
+    queues_.reset(new Queue[num_threads_]);
+    accum_.assign(num_threads_ * block_size_, 0.0f);
+    scratch_.assign(num_threads_ * block_size_, 0.0f);
+    ticks_.store(0);
+    voice_cost_ = 0.0;
+    CycleStats::TicksPerSecond(); // start calibrating early
+}
+
+void VoiceRenderer::Process(RenderVoice  render,
+                            void *const *voices,
+                            size_t       num_voices,
+                            float *      out,
+                            size_t       size)
+{
+    size_ = size < block_size_ ? size : block_size_;
+    for(size_t i = 0; i < size_; i++)
+    {
+        out[i] = 0.0f;
+    }
+    if(num_voices == 0)
+    {
+        return;
+    }
+    render_ = render;
+    voices_ = voices;
+    ticks_.store(0, std::memory_order_relaxed);
+
+    // equal runs, the first num_voices % num_threads one voice longer
+    size_t start = 0;
+    for(size_t t = 0; t < num_threads_; t++)
+    {
+        const size_t count = num_voices / num_threads_
+                             + (t < num_voices % num_threads_ ? 1 : 0);
+        queues_[t].range.store(Pack(start, start + count),
+                               std::memory_order_relaxed);
+        start += count;
+    }
+
+    if(pool_ && num_threads_ > 1)
+    {
+        pool_->Run(&VoiceRenderer::Job, this);
+    }
+    else
+    {
+        Job(this, 0);
+    }
+
+    // reduction
+    for(size_t t = 0; t < num_threads_; t++)
+    {
+        const float *acc = &accum_[t * block_size_];
+        for(size_t i = 0; i < size_; i++)
+        {
+            out[i] += acc[i];
+        }
+    }
+
+    // running average of the cost per voice and sample
+    const double seconds = ticks_.load(std::memory_order_relaxed)
+                           / CycleStats::TicksPerSecond();
+    const double cost = seconds / (num_voices * size_);
+    voice_cost_ = voice_cost_ > 0.0 ? voice_cost_ + 0.05 * (cost - voice_cost_)
+                                    : cost;
+}
+
+size_t VoiceRenderer::GetVoiceCapacity(float sample_rate, float load) const
+{
+    if(voice_cost_ <= 0.0)
+    {
+        return 0;
+    }
+    return (size_t)(num_threads_ * load / (sample_rate * voice_cost_));
+}
+
+bool VoiceRenderer::PopFront(size_t queue, uint32_t &task)
+{
+    std::atomic<uint64_t> &range = queues_[queue].range;
+    uint64_t               r     = range.load(std::memory_order_relaxed);
+    while(true)
+    {
+        const uint32_t front = (uint32_t)r, back = (uint32_t)(r >> 32);
+        if(front >= back)
+        {
+            return false;
+        }
+        if(range.compare_exchange_weak(r, Pack(front + 1, back)))
+        {
+            task = front;
+            return true;
+        }
+    }
+}
+
+bool VoiceRenderer::PopBack(size_t queue, uint32_t &task)
+{
+    std::atomic<uint64_t> &range = queues_[queue].range;
+    uint64_t               r     = range.load(std::memory_order_relaxed);
+    while(true)
+    {
+        const uint32_t front = (uint32_t)r, back = (uint32_t)(r >> 32);
+        if(front >= back)
+        {
+            return false;
+        }
+        if(range.compare_exchange_weak(r, Pack(front, back - 1)))
+        {
+            task = back - 1;
+            return true;
+        }
+    }
+}
+
+void VoiceRenderer::Job(void *context, size_t thread)
+{
+    VoiceRenderer *r       = static_cast<VoiceRenderer *>(context);
+    const size_t   size    = r->size_;
+    float *        acc     = &r->accum_[thread * r->block_size_];
+    float *        scratch = &r->scratch_[thread * r->block_size_];
+    for(size_t i = 0; i < size; i++)
+    {
+        acc[i] = 0.0f;
+    }
+
+    const uint64_t t0 = ReadCycleCounter();
+    uint32_t       task;
+    while(true)
+    {
+        // own run first, then steal from the back of the others
+        bool found = r->PopFront(thread, task);
+        for(size_t k = 1; !found && k < r->num_threads_; k++)
+        {
+            found = r->PopBack((thread + k) % r->num_threads_, task);
+        }
+        if(!found)
+        {
+            break;
+        }
+        r->render_(r->voices_[task], scratch, size);
+        for(size_t i = 0; i < size; i++)
+        {
+            acc[i] += scratch[i];
+        }
+    }
+    r->ticks_.fetch_add(ReadCycleCounter() - t0, std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,130 @@
+#pragma once
+#ifndef DSY_VOICERENDERER_H
+#define DSY_VOICERENDERER_H
+
+#ifndef DSY_NO_THREADS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "Utility/threadpool.h"
+
+/** @file voicerenderer.h */
+
+namespace daisysp
+{
+/**
+       @brief Renders a set of voices across a ThreadPool by work stealing
+       @date Oct 2026
+       Each block the active voices are dealt out to the threads in equal
+       runs. A thread renders its own run front to back and, once it is
+       empty, steals single voices from the back of the others, so uneven
+       voices (a StringVoice in its attack next to one near silence) still
+       keep every core busy. Each thread sums into a private accumulator,
+       the accumulators are added together at the end. \n
+       The queues are one packed atomic word each, popped and stolen by
+       compare and swap with no locks. Idle workers spin and then park, see
+       ThreadPool. \n
+       The renderer also measures the average cost of a voice, so
+       GetVoiceCapacity() gives a polyphony limit that scales with the
+       number of cores.
+
+       usage:
+
+       VoiceRenderer renderer;
+       renderer.Init(&pool, 64);
+       ...
+       // voices holds pointers to the active StringVoice objects
+       renderer.Process(VoiceRenderer::Render<StringVoice>, voices,
+                        num_active, out, 64);
+*/
+class VoiceRenderer
+{
+  public:
+    VoiceRenderer() {}
+    ~VoiceRenderer() {}
+
+    /** Renders one voice
+        \param voice pointer from the list passed to Process()
+        \param out size samples to write
+        \param size number of samples
+    */
+    typedef void (*RenderVoice)(void *voice, float *out, size_t size);
+
+    /** RenderVoice for any voice with a float Process() */
+    template <typename Voice>
+    static void Render(void *voice, float *out, size_t size)
+    {
+        Voice *v = static_cast<Voice *>(voice);
+        for(size_t i = 0; i < size; i++)
+        {
+            out[i] = v->Process();
+        }
+    }
+
+    /** Sets up the accumulators
+        \param pool threads to render on, nullptr renders on the caller
+        \param block_size largest size passed to Process()
+    */
+    void Init(ThreadPool *pool, size_t block_size);
+
+    /** Renders voices and writes their sum to out
+        \param render called once per voice
+        \param voices the voices to render, each rendered by one thread
+        \param num_voices number of voices
+        \param out size samples
+        \param size samples, up to the block size
+    */
+    void Process(RenderVoice  render,
+                 void *const *voices,
+                 size_t       num_voices,
+                 float *      out,
+                 size_t       size);
+
+    /** Voices that fit in real time on all threads, from the measured cost
+        of a voice. 0 until a block has been rendered.
+        \param sample_rate audio engine sample rate
+        \param load share of the block time to use, e.g. 0.7
+    */
+    size_t GetVoiceCapacity(float sample_rate, float load = 0.7f) const;
+
+    /** Measured average render time of a voice per sample, in seconds */
+    inline double GetVoiceCost() const { return voice_cost_; }
+
+  private:
+    // front in the low half, back in the high half, on its own cache line
+    struct Queue
+    {
+        std::atomic<uint64_t> range;
+        char                  pad[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    static inline uint64_t Pack(uint32_t front, uint32_t back)
+    {
+        return ((uint64_t)back << 32) | front;
+    }
+
+    static void Job(void *context, size_t thread);
+
+    bool PopFront(size_t queue, uint32_t &task);
+    bool PopBack(size_t queue, uint32_t &task);
+
+    ThreadPool *pool_;
+    size_t      num_threads_, block_size_, size_;
+
+    RenderVoice  render_;
+    void *const *voices_;
+
+    std::unique_ptr<Queue[]> queues_;
+    std::vector<float>       accum_;   // one block per thread
+    std::vector<float>       scratch_; // one block per thread
+
+    std::atomic<uint64_t> ticks_; // voice render time in this block
+    double                voice_cost_;
+};
+
+} // namespace daisysp
+#endif
+#endif
@@ -5,7 +5,7 @@
 //        should be useful outside of the ARM context with different build configurations.
 //
 //    A few general notes about the contents of the library:
-//        - all memory usage is static.
+//        - all memory usage is static, or taken once at Init from a caller-owned Allocator.
 //        - in cases of potentially large memory usage: the user will either supply a buffer and a size, or the class will be a template that can have size set at compile time.
 //        - all modules will have an Init() function, and a Process() function.
 //        - all modules, unless otherwise noted, will process a single sample at a time.
@@ -24,6 +24,7 @@
 /** Drum Modules */
 #include "Drums/analogbassdrum.h"
 #include "Drums/analogsnaredrum.h"
+#include "Drums/drumkit.h"
 #include "Drums/hihat.h"
 #include "Drums/synthbassdrum.h"
 #include "Drums/synthsnaredrum.h"
@@ -39,8 +40,10 @@
 #include "Effects/bitcrush.h"
 #include "Effects/chorus.h"
 #include "Effects/decimator.h"
+#include "Effects/fdnreverb.h"
 #include "Effects/flanger.h"
 #include "Effects/fold.h"
+#include "Effects/granular.h"
 #include "Effects/overdrive.h"
 #include "Effects/reverbsc.h"
 #include "Effects/phaser.h"
@@ -56,6 +59,7 @@
 #include "Filters/comb.h"
 #include "Filters/mode.h"
 #include "Filters/moogladder.h"
+#include "Filters/multimoogladder.h"
 #include "Filters/nlfilt.h"
 #include "Filters/svf.h"
 #include "Filters/tone.h"
@@ -80,27 +84,44 @@
 #include "PhysicalModeling/stringvoice.h"
 
 /** Synthesis Modules */
+#include "Synthesis/additiveosc.h"
 #include "Synthesis/blosc.h"
 #include "Synthesis/fm2.h"
+#include "Synthesis/fmengine.h"
 #include "Synthesis/formantosc.h"
+#include "Synthesis/multioscillator.h"
 #include "Synthesis/harmonic_osc.h"
 #include "Synthesis/oscillator.h"
 #include "Synthesis/oscillatorbank.h"
+#include "Synthesis/polyoscillatorbank.h"
+#include "Synthesis/unisonsaw.h"
 #include "Synthesis/variablesawosc.h"
 #include "Synthesis/variableshapeosc.h"
 #include "Synthesis/vosim.h"
+#include "Synthesis/wavetableosc.h"
 #include "Synthesis/zoscillator.h"
 
 /** Utility Modules */
+#include "Utility/allocator.h"
+#include "Utility/cyclestats.h"
 #include "Utility/dcblock.h"
 #include "Utility/delayline.h"
+#include "Utility/denormal.h"
 #include "Utility/dsp.h"
+#include "Utility/graph.h"
 #include "Utility/jitter.h"
 #include "Utility/looper.h"
 #include "Utility/maytrig.h"
+#include "Utility/meter.h"
 #include "Utility/metro.h"
+#include "Utility/phaseaccumulator.h"
 #include "Utility/port.h"
+#include "Utility/profile.h"
+#include "Utility/ringbuffer.h"
 #include "Utility/samplehold.h"
+#include "Utility/silencedetector.h"
 #include "Utility/smooth_random.h"
+#include "Utility/threadpool.h"
+#include "Utility/voicerenderer.h"
 
 #endif
@@ -0,0 +1,138 @@
+/** Cost of the denormal guard on decaying feedback structures.
+
+    Feeds a short noise burst and then silence into ReverbSc, MoogLadder
+    and MultiMoogLadder, and times every block of the silent tail, once with the
+    FPU left as it is and once under ScopedFlushDenormals. As the tails
+    decay their state passes through the subnormal range, which x86 runs
+    in microcode unless flush-to-zero is set.
+
+    usage: denormal_bench [seconds of tail]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "daisysp.h"
+
+using namespace daisysp;
+
+static const float  kSampleRate = 48000.0f;
+static const size_t kBlockSize  = 64;
+
+struct Result
+{
+    double mean, p99, max;
+};
+
+template <typename Render>
+static Result Run(bool flush, float tail_seconds, Render render)
+{
+    // the guard is in scope for the whole run, as in an audio callback
+    ScopedFlushDenormals *ftz = flush ? new ScopedFlushDenormals : nullptr;
+
+    float  block[kBlockSize];
+    size_t burst = (size_t)(0.5f * kSampleRate / kBlockSize);
+    for(size_t b = 0; b < burst; b++)
+    {
+        for(size_t i = 0; i < kBlockSize; i++)
+        {
+            block[i] = rand() * kRandFrac * 2.0f - 1.0f;
+        }
+        render(block);
+    }
+
+    CycleStats stats;
+    stats.Init();
+    size_t tail = (size_t)(tail_seconds * kSampleRate / kBlockSize);
+    for(size_t b = 0; b < tail; b++)
+    {
+        for(size_t i = 0; i < kBlockSize; i++)
+        {
+            block[i] = 0.0f;
+        }
+        CycleStats::Scope timer(stats);
+        render(block);
+    }
+    delete ftz;
+
+    Result r;
+    r.mean = stats.GetMean();
+    r.p99  = stats.GetPercentile(0.99f);
+    r.max  = stats.GetMax();
+    return r;
+}
+
+static void Report(const char *name, const Result &off, const Result &on)
+{
+    printf("%-12s %10.2f %10.2f %10.2f   %10.2f %10.2f %10.2f\n",
+           name,
+           off.mean * 1e6,
+           off.p99 * 1e6,
+           off.max * 1e6,
+           on.mean * 1e6,
+           on.p99 * 1e6,
+           on.max * 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    const float tail = argc > 1 ? (float)atof(argv[1]) : 30.0f;
+    printf("%zu sample blocks, %.0f s of tail, us per block\n",
+           kBlockSize,
+           tail);
+    printf("%-12s %10s %10s %10s   %10s %10s %10s\n",
+           "",
+           "mean",
+           "p99",
+           "max",
+           "ftz mean",
+           "ftz p99",
+           "ftz max");
+
+    Result result[2];
+    for(int flush = 0; flush < 2; flush++)
+    {
+        static ReverbSc verb;
+        verb.Init(kSampleRate);
+        verb.SetFeedback(0.9f);
+        verb.SetLpFreq(10000.0f);
+        result[flush] = Run(flush, tail, [](float *block) {
+            float l, r;
+            for(size_t i = 0; i < kBlockSize; i++)
+            {
+                verb.Process(block[i], block[i], &l, &r);
+            }
+        });
+    }
+    Report("ReverbSc", result[0], result[1]);
+
+    for(int flush = 0; flush < 2; flush++)
+    {
+        static MoogLadder filter;
+        filter.Init(kSampleRate);
+        filter.SetFreq(200.0f);
+        filter.SetRes(0.7f);
+        result[flush] = Run(flush, tail, [](float *block) {
+            for(size_t i = 0; i < kBlockSize; i++)
+            {
+                block[i] = filter.Process(block[i]);
+            }
+        });
+    }
+    Report("MoogLadder", result[0], result[1]);
+
+    for(int flush = 0; flush < 2; flush++)
+    {
+        static MultiMoogLadder<4> bank;
+        bank.Init(kSampleRate);
+        for(size_t ch = 0; ch < 4; ch++)
+        {
+            bank.SetFreq(ch, 200.0f * (ch + 1));
+            bank.SetRes(ch, 0.7f);
+        }
+        result[flush] = Run(flush, tail, [](float *block) {
+            float *io[4] = {block, block, block, block};
+            bank.ProcessBlock(io, io, kBlockSize);
+        });
+    }
+    Report("MultiMoog x4", result[0], result[1]);
+    return 0;
+}
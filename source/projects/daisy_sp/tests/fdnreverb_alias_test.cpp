@@ -0,0 +1,59 @@
+/** FdnReverb::ProcessBlock with aliased buffers.
+
+    Processing in place must give the same output as separate input and
+    output buffers.
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "daisysp.h"
+
+using namespace daisysp;
+
+static const float  kSampleRate = 48000.0f;
+static const size_t kBlockSize  = 64;
+static const size_t kBlocks     = 200;
+
+static FdnReverb<16> reverb[2];
+static uint8_t       pool[2][1 << 20];
+
+int main()
+{
+    for(int r = 0; r < 2; r++)
+    {
+        ArenaAllocator arena;
+        arena.Init(pool[r], sizeof(pool[r]));
+        if(!reverb[r].Init(kSampleRate, arena))
+        {
+            printf("FAIL: allocator too small\n");
+            return 1;
+        }
+    }
+
+    float max_diff = 0.0f;
+    srand(1);
+    for(size_t b = 0; b < kBlocks; b++)
+    {
+        float in_l[kBlockSize], in_r[kBlockSize];
+        float out_l[kBlockSize], out_r[kBlockSize];
+        for(size_t i = 0; i < kBlockSize; i++)
+        {
+            in_l[i] = rand() * kRandFrac * 2.0f - 1.0f;
+            in_r[i] = rand() * kRandFrac * 2.0f - 1.0f;
+        }
+        reverb[0].ProcessBlock(in_l, in_r, out_l, out_r, kBlockSize);
+        reverb[1].ProcessBlock(in_l, in_r, in_l, in_r, kBlockSize);
+        for(size_t i = 0; i < kBlockSize; i++)
+        {
+            max_diff = fmaxf(max_diff, fabsf(out_l[i] - in_l[i]));
+            max_diff = fmaxf(max_diff, fabsf(out_r[i] - in_r[i]));
+        }
+    }
+
+    if(max_diff != 0.0f)
+    {
+        printf("FAIL: in place output differs by %g\n", max_diff);
+        return 1;
+    }
+    return 0;
+}
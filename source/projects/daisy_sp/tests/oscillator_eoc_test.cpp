@@ -0,0 +1,68 @@
+/** Oscillator end of cycle and end of rise flags.
+
+    EOC and EOR each fire once per cycle, never on the same sample, for
+    positive and negative frequencies alike.
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "daisysp.h"
+
+using namespace daisysp;
+
+static int failures = 0;
+
+static void Check(bool ok, const char *what, float value)
+{
+    if(!ok)
+    {
+        printf("FAIL: %s (%g)\n", what, value);
+        failures++;
+    }
+}
+
+int main()
+{
+    const float kSampleRate = 48000.0f;
+
+    const float freqs[] = {100.0f, -100.0f, 1000.0f, -1000.0f};
+    for(float freq : freqs)
+    {
+        Oscillator osc;
+        osc.Init(kSampleRate);
+        osc.SetFreq(freq);
+
+        int  eoc = 0, eor = 0;
+        bool together = false;
+        for(int i = 0; i < (int)kSampleRate; i++)
+        {
+            osc.Process();
+            eoc += osc.IsEOC();
+            eor += osc.IsEOR();
+            together |= osc.IsEOC() && osc.IsEOR();
+        }
+
+        const int cycles = (int)fabsf(freq);
+        Check(abs(eoc - cycles) <= 1, "EOC count", freq);
+        Check(abs(eor - cycles) <= 1, "EOR count", freq);
+        Check(!together, "EOC and EOR on the same sample", freq);
+    }
+
+    // the accumulator itself wraps once per cycle in either direction
+    const float increments[] = {0.01f, -0.01f};
+    for(float increment : increments)
+    {
+        PhaseAccumulator phase;
+        phase.Init();
+        phase.SetIncrement(increment);
+
+        int wraps = 0;
+        for(int i = 0; i < 1000; i++)
+        {
+            wraps += phase.Advance();
+        }
+        Check(abs(wraps - 10) <= 1, "PhaseAccumulator wraps", increment);
+    }
+
+    return failures ? 1 : 0;
+}
@@ -3,12 +3,15 @@
     dsp.blosc~: daisysp band limited oscillator
 */
 #include "blosc.h"
+#include "denormal.h"
 #include <cstdlib>
 
 #include "ext.h"
 #include "ext_obex.h"
 #include "z_dsp.h"
 
+#include "mxd_stats.h"
+
 
 enum {
     // FREQ is assigned to default left inlet
@@ -29,6 +32,7 @@ typedef struct _mxd {
     long m_in;                  // space for the inlet number used by all the proxies
     void *inlets[MAX_INLET_INDEX];
     // t_outlet *outlet; 
+    t_mxd_stats stats;          // perform64 timing, see mxd_stats.h
 } t_mxd;
 
 
@@ -64,6 +68,7 @@ void ext_main(void *r)
     class_addmethod(c, (method)mxd_bang,     "bang",                0);
     class_addmethod(c, (method)mxd_dsp64,    "dsp64",    A_CANT,    0);
     class_addmethod(c, (method)mxd_assist,   "assist",   A_CANT,    0);
+    mxd_stats_setup<t_mxd>(c);
 
     class_dspinit(c);
     class_register(CLASS_BOX, c);
@@ -79,6 +84,7 @@ void *mxd_new(t_symbol *s, long argc, t_atom *argv)
         // use 0 if you don't need signal inlets
 
         // x->outlet = bangout(x);      // optional outlet to bang out at end of cycle
+        mxd_stats_new(&x->stats, (t_object *)x);  // rightmost outlet: stats
         outlet_new(x, "signal");        // signal outlet (note "signal" rather than NULL)
         
 
@@ -100,6 +106,7 @@ void mxd_free(t_mxd *x)
 {
     delete x->osc;
     dsp_free((t_pxobject *)x);
+    mxd_stats_free(&x->stats);
     for(int i = (MAX_INLET_INDEX - 1); i > 0; i--) {
         object_free(x->inlets[i]);
     }
@@ -165,12 +172,16 @@ void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long
     x->osc->Init(samplerate);
     x->osc->Reset();
 
+    mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);
+
     object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64, 0, NULL);
 }
 
 
 void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
 {
+    daisysp::ScopedFlushDenormals ftz;  // FTZ/DAZ for the duration of the vector
+    mxd_stats_scope timer(&x->stats);  // timed until perform returns
     t_double *inL = ins[0];     // we get audio for each inlet of the object from the **ins argument
     t_double *outL = outs[0];   // we get audio for each outlet of the object from the **outs argument
     int n = sampleframes;       // n = 64
@@ -0,0 +1,271 @@
+/**
+    @file
+    dsp.drumkit~: daisy_sp eight voice drum machine
+*/
+#include "drumkit.h"
+#include "analogbassdrum.h"
+#include "analogsnaredrum.h"
+#include "synthbassdrum.h"
+#include "synthsnaredrum.h"
+#include "hihat.h"
+#include "denormal.h"
+#include <cstdlib>
+
+#include "ext.h"
+#include "ext_obex.h"
+#include "z_dsp.h"
+#include "mxd_events.h"
+#include "mxd_stats.h"
+
+
+enum {
+    KICK,           // AnalogBassDrum
+    SYNTH_KICK,     // SyntheticBassDrum
+    SNARE,          // AnalogSnareDrum
+    SYNTH_SNARE,    // SyntheticSnareDrum, tone sets the FM amount
+    CLOSED_HAT,     // HiHat<SquareNoise>
+    OPEN_HAT,       // HiHat<SquareNoise>, long decay
+    RING_HAT,       // HiHat<RingModNoise>
+    TOM,            // AnalogBassDrum tuned up
+    NUM_VOICES
+};
+
+
+enum {
+    HIT,            // event type: index is the voice, value the accent
+};
+
+
+// the drums and the engine mixing them, allocated together
+struct Kit {
+    daisysp::AnalogBassDrum kick;
+    daisysp::SyntheticBassDrum synth_kick;
+    daisysp::AnalogSnareDrum snare;
+    daisysp::SyntheticSnareDrum synth_snare;
+    daisysp::HiHat<> closed_hat;
+    daisysp::HiHat<> open_hat;
+    daisysp::HiHat<daisysp::RingModNoise> ring_hat;
+    daisysp::AnalogBassDrum tom;
+    daisysp::DrumKit<NUM_VOICES> engine;
+};
+
+
+typedef struct _mxd {
+    t_pxobject ob;              // the object itself (t_pxobject in MSP instead of t_object)
+    Kit* kit;                   // daisy drums
+    float* buffer;              // one signal vector of mixed output
+    double freq[NUM_VOICES];    // root frequency of each voice in Hz
+    double tone[NUM_VOICES];    // brightness of each voice (range 0 - 1)
+    double decay[NUM_VOICES];   // length of each voice (range 0 - 1)
+    double level[NUM_VOICES];   // mix level of each voice
+    t_mxd_events events;        // time-stamped hits, placed sample-accurately in perform64
+    t_mxd_stats stats;          // perform64 timing, see mxd_stats.h
+} t_mxd;
+
+
+// method prototypes
+void *mxd_new(t_symbol *s, long argc, t_atom *argv);
+void mxd_free(t_mxd *x);
+void mxd_assist(t_mxd *x, void *b, long m, long a, char *s);
+void mxd_int(t_mxd *x, long i);
+void mxd_anything(t_mxd* x, t_symbol* s, long argc, t_atom* argv);
+void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags);
+void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam);
+
+
+// global class pointer variable
+static t_class *mxd_class = NULL;
+
+
+//-----------------------------------------------------------------------------------------------
+
+void ext_main(void *r)
+{
+    t_class *c = class_new("dsp.drumkit~", (method)mxd_new, (method)mxd_free, (long)sizeof(t_mxd), 0L, A_GIMME, 0);
+
+    class_addmethod(c, (method)mxd_int,      "int",      A_LONG,    0);
+    class_addmethod(c, (method)mxd_anything, "anything", A_GIMME,   0);
+    class_addmethod(c, (method)mxd_dsp64,    "dsp64",    A_CANT,    0);
+    class_addmethod(c, (method)mxd_assist,   "assist",   A_CANT,    0);
+    mxd_stats_setup<t_mxd>(c);
+
+    class_dspinit(c);
+    class_register(CLASS_BOX, c);
+    mxd_class = c;
+}
+
+void *mxd_new(t_symbol *s, long argc, t_atom *argv)
+{
+    t_mxd *x = (t_mxd *)object_alloc(mxd_class);
+
+    if (x) {
+        dsp_setup((t_pxobject *)x, 0);  // no signal inlets, hits arrive as messages
+
+        mxd_stats_new(&x->stats, (t_object *)x);  // rightmost outlet: stats
+        outlet_new(x, "signal");
+
+        x->kit = new Kit;
+        x->buffer = NULL;
+        mxd_events_init(&x->events);
+
+        static const double freq[NUM_VOICES] = {50.0, 50.0, 200.0, 200.0, 3000.0, 3000.0, 3000.0, 110.0};
+        static const double tone[NUM_VOICES] = {0.5, 0.5, 0.5, 0.1, 0.5, 0.5, 0.5, 0.5};
+        static const double decay[NUM_VOICES] = {0.5, 0.5, 0.5, 0.5, 0.2, 0.8, 0.5, 0.3};
+        for (int i = 0; i < NUM_VOICES; i++) {
+            x->freq[i] = freq[i];
+            x->tone[i] = tone[i];
+            x->decay[i] = decay[i];
+            x->level[i] = 1.0;
+        }
+    }
+    return (x);
+}
+
+
+void mxd_free(t_mxd *x)
+{
+    dsp_free((t_pxobject *)x);
+    mxd_stats_free(&x->stats);
+    mxd_events_free(&x->events);
+    delete x->kit;
+    delete[] x->buffer;
+}
+
+
+void mxd_assist(t_mxd *x, void *b, long m, long a, char *s)
+{
+    if (m == ASSIST_INLET) {
+        sprintf(s, "hit <voice> [accent], freq/tone/decay/level <voice> <value>, int hits a voice");
+    }
+    else {
+        sprintf(s, "(signal) drum mix");
+    }
+}
+
+
+static bool valid_voice(long voice)
+{
+    return voice >= 0 && voice < NUM_VOICES;
+}
+
+
+void mxd_int(t_mxd *x, long i)
+{
+    if (valid_voice(i)) {
+        mxd_events_push(&x->events, HIT, i, 0.8);
+    }
+}
+
+
+void mxd_anything(t_mxd* x, t_symbol* s, long argc, t_atom* argv)
+{
+    if (s == gensym("") || argc < 1) {
+        return;
+    }
+    long voice = atom_getlong(argv);
+    if (!valid_voice(voice)) {
+        return;
+    }
+
+    if (s == gensym("hit")) {
+        mxd_events_push(&x->events, HIT, voice, argc > 1 ? atom_getfloat(argv + 1) : 0.8);
+    }
+    else if (argc > 1) {
+        double value = atom_getfloat(argv + 1);
+        if (s == gensym("freq")) {
+            x->freq[voice] = value;
+        }
+        else if (s == gensym("tone")) {
+            x->tone[voice] = value;
+        }
+        else if (s == gensym("decay")) {
+            x->decay[voice] = value;
+        }
+        else if (s == gensym("level")) {
+            x->level[voice] = value;
+        }
+    }
+}
+
+
+void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags)
+{
+    Kit *k = x->kit;
+    k->kick.Init(samplerate);
+    k->synth_kick.Init(samplerate);
+    k->snare.Init(samplerate);
+    k->synth_snare.Init(samplerate);
+    k->closed_hat.Init(samplerate);
+    k->open_hat.Init(samplerate);
+    k->ring_hat.Init(samplerate);
+    k->tom.Init(samplerate);
+
+    // voice order follows the enum
+    k->engine.Init(samplerate);
+    k->engine.AddVoice(&k->kick);
+    k->engine.AddVoice(&k->synth_kick);
+    k->engine.AddVoice(&k->snare);
+    k->engine.AddVoice(&k->synth_snare);
+    k->engine.AddVoice(&k->closed_hat);
+    k->engine.AddVoice(&k->open_hat);
+    k->engine.AddVoice(&k->ring_hat);
+    k->engine.AddVoice(&k->tom);
+
+    delete[] x->buffer;
+    x->buffer = new float[maxvectorsize];
+    mxd_events_dsp(&x->events, samplerate);
+
+    mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);
+
+    object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64, 0, NULL);
+}
+
+
+void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
+{
+    daisysp::ScopedFlushDenormals ftz;  // FTZ/DAZ for the duration of the vector
+    mxd_stats_scope timer(&x->stats);  // timed until perform returns
+    Kit *k = x->kit;
+    t_double *out = outs[0];
+
+    k->kick.SetFreq(x->freq[KICK]);
+    k->kick.SetTone(x->tone[KICK]);
+    k->kick.SetDecay(x->decay[KICK]);
+    k->synth_kick.SetFreq(x->freq[SYNTH_KICK]);
+    k->synth_kick.SetTone(x->tone[SYNTH_KICK]);
+    k->synth_kick.SetDecay(x->decay[SYNTH_KICK]);
+    k->snare.SetFreq(x->freq[SNARE]);
+    k->snare.SetTone(x->tone[SNARE]);
+    k->snare.SetDecay(x->decay[SNARE]);
+    k->synth_snare.SetFreq(x->freq[SYNTH_SNARE]);
+    k->synth_snare.SetFmAmount(x->tone[SYNTH_SNARE]);
+    k->synth_snare.SetDecay(x->decay[SYNTH_SNARE]);
+    k->closed_hat.SetFreq(x->freq[CLOSED_HAT]);
+    k->closed_hat.SetTone(x->tone[CLOSED_HAT]);
+    k->closed_hat.SetDecay(x->decay[CLOSED_HAT]);
+    k->open_hat.SetFreq(x->freq[OPEN_HAT]);
+    k->open_hat.SetTone(x->tone[OPEN_HAT]);
+    k->open_hat.SetDecay(x->decay[OPEN_HAT]);
+    k->ring_hat.SetFreq(x->freq[RING_HAT]);
+    k->ring_hat.SetTone(x->tone[RING_HAT]);
+    k->ring_hat.SetDecay(x->decay[RING_HAT]);
+    k->tom.SetFreq(x->freq[TOM]);
+    k->tom.SetTone(x->tone[TOM]);
+    k->tom.SetDecay(x->decay[TOM]);
+
+    for (int i = 0; i < NUM_VOICES; i++) {
+        k->engine.SetLevel(i, x->level[i]);
+    }
+
+    // the engine splits the vector at each hit's offset itself
+    mxd_events_vector(&x->events, sampleframes);
+    t_mxd_event ev;
+    while (mxd_events_pop(&x->events, &ev)) {
+        k->engine.Trigger(ev.index, ev.value, ev.offset);
+    }
+
+    k->engine.Process(x->buffer, sampleframes);
+    for (long n = 0; n < sampleframes; ++n) {
+        out[n] = x->buffer[n];
+    }
+}
@@ -5,9 +5,12 @@
 #include <cstdlib>
 
 #include "ext.h"
+#include "denormal.h"
 #include "ext_obex.h"
 #include "z_dsp.h"
 
+#include "mxd_stats.h"
+
 #define MAX_INLET_INDEX 2
 
 // struct to represent the object's state
@@ -15,6 +18,7 @@ typedef struct _mxd {
     t_pxobject ob;              // the object itself (t_pxobject in MSP instead of t_object)
     long m_in;                  // space for the inlet number used by all the proxies
     void *inlets[MAX_INLET_INDEX];
+    t_mxd_stats stats;          // perform64 timing, see mxd_stats.h
 } t_mxd;
 
 
@@ -45,6 +49,7 @@ void ext_main(void *r)
     class_addmethod(c, (method)mxd_bang,     "bang",                0);
     class_addmethod(c, (method)mxd_dsp64,    "dsp64",    A_CANT,    0);
     class_addmethod(c, (method)mxd_assist,   "assist",   A_CANT,    0);
+    mxd_stats_setup<t_mxd>(c);
 
     class_dspinit(c);
     class_register(CLASS_BOX, c);
@@ -59,6 +64,7 @@ void *mxd_new(t_symbol *s, long argc, t_atom *argv)
         dsp_setup((t_pxobject *)x, 2);  // MSP inlets: arg is # of signal inlets and is REQUIRED!
         // use 0 if you don't need signal inlets
 
+        mxd_stats_new(&x->stats, (t_object *)x);  // rightmost outlet: stats
         outlet_new(x, "signal");        // signal outlet (note "signal" rather than NULL)
         outlet_new(x, "signal");        // signal outlet (note "signal" rather than NULL)
 
@@ -73,6 +79,7 @@ void *mxd_new(t_symbol *s, long argc, t_atom *argv)
 void mxd_free(t_mxd *x)
 {
     dsp_free((t_pxobject *)x);
+    mxd_stats_free(&x->stats);
     for(int i = (MAX_INLET_INDEX - 1); i > 0; i--) {
         object_free(x->inlets[i]);
     }
@@ -112,12 +119,16 @@ void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long
     post("sample rate: %f", samplerate);
     post("maxvectorsize: %d", maxvectorsize);
 
+    mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);
+
     object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64, 0, NULL);
 }
 
 
 void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
 {
+    daisysp::ScopedFlushDenormals ftz;  // FTZ/DAZ for the duration of the vector
+    mxd_stats_scope timer(&x->stats);  // timed until perform returns
     t_double *inL = ins[0];     // we get audio for each inlet of the object from the **ins argument
     t_double *inR = ins[1];     // we get audio for each inlet of the object from the **ins argument
     t_double *outL = outs[0];   // we get audio for each outlet of the object from the **outs argument
@@ -3,12 +3,15 @@
     dsp.oscbank~: daisysp A mixture of 7 sawtooth and square waveforms in the style of divide-down organs
 */
 #include "oscillatorbank.h"
+#include "denormal.h"
 #include <cstdlib>
 
 #include "ext.h"
 #include "ext_obex.h"
 #include "z_dsp.h"
 
+#include "mxd_stats.h"
+
 
 typedef struct _mxd {
     t_pxobject ob;                  // the object itself (t_pxobject in MSP instead of t_object)
@@ -18,6 +21,7 @@ typedef struct _mxd {
     double amp;                     // Set a single amplitude 0-1
     int amp_idx;                    // Index of osc to be changed (0-6)
     double gain;                    // Set overall gain. 0-1
+    t_mxd_stats stats;          // perform64 timing, see mxd_stats.h
 } t_mxd;
 
 
@@ -50,6 +54,7 @@ void ext_main(void *r)
     class_addmethod(c, (method)mxd_bang,     "bang",                0);
     class_addmethod(c, (method)mxd_dsp64,    "dsp64",    A_CANT,    0);
     class_addmethod(c, (method)mxd_assist,   "assist",   A_CANT,    0);
+    mxd_stats_setup<t_mxd>(c);
 
     class_dspinit(c);
     class_register(CLASS_BOX, c);
@@ -63,6 +68,7 @@ void *mxd_new(t_symbol *s, long argc, t_atom *argv)
     if (x) {
         dsp_setup((t_pxobject *)x, 1);  // MSP inlets: arg is # of signal inlets and is REQUIRED!
 
+        mxd_stats_new(&x->stats, (t_object *)x);  // rightmost outlet: stats
         outlet_new(x, "signal");        // signal outlet (note "signal" rather than NULL)
 
         x->osc = new daisysp::OscillatorBank;
@@ -79,6 +85,7 @@ void mxd_free(t_mxd *x)
 {
     delete x->osc;
     dsp_free((t_pxobject *)x);
+    mxd_stats_free(&x->stats);
 }
 
 
@@ -127,12 +134,16 @@ void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long
 
     x->osc->Init(samplerate);
 
+    mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);
+
     object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64, 0, NULL);
 }
 
 
 void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
 {
+    daisysp::ScopedFlushDenormals ftz;  // FTZ/DAZ for the duration of the vector
+    mxd_stats_scope timer(&x->stats);  // timed until perform returns
     t_double *inL = ins[0];     // we get audio for each inlet of the object from the **ins argument
     t_double *outL = outs[0];   // we get audio for each outlet of the object from the **outs argument
     int n = sampleframes;       // n = 64
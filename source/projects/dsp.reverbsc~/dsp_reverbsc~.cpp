@@ -3,22 +3,33 @@
     dsp.strev~: daisy_sp stereo reverb for Max
 */
 #include "reverbsc.h"
+#include "denormal.h"
 #include <cstdlib>
 
 #include "ext.h"
 #include "ext_obex.h"
 #include "z_dsp.h"
 
+#include "mxd_silence.h"
+#include "mxd_stats.h"
+
 #define N_CHANNELS 2
 
+// DaisySP sample type: double runs the reverb natively on Max's 64-bit
+// signal vectors, build with -DMXD_SAMPLE_T=float for the float path
+#ifndef MXD_SAMPLE_T
+#define MXD_SAMPLE_T double
+#endif
+
 
 
 // struct to represent the object's state
 typedef struct _mxd {
     t_pxobject ob;              // the object itself (t_pxobject in MSP instead of t_object)
-    daisysp::ReverbSc* rev;     // daisy rev object
+    daisysp::ReverbScT<MXD_SAMPLE_T>* rev;     // daisy rev object
     double feedback;            // controls the reverb time, reverb tail becomes infinite when set to 1.0 (range 0.0 to 1.0)
     double lp_freq;             // controls the internal dampening filter's cutoff frequency. (range: 0.0 to sample_rate / 2)
+    t_mxd_stats stats;          // perform64 timing, see mxd_stats.h
 } t_mxd;
 
 
@@ -50,6 +61,7 @@ void ext_main(void *r)
     class_addmethod(c, (method)mxd_bang,     "bang",                0);
     class_addmethod(c, (method)mxd_dsp64,    "dsp64",    A_CANT,    0);
     class_addmethod(c, (method)mxd_assist,   "assist",   A_CANT,    0);
+    mxd_stats_setup<t_mxd>(c);
 
     class_dspinit(c);
     class_register(CLASS_BOX, c);
@@ -65,10 +77,11 @@ void *mxd_new(t_symbol *s, long argc, t_atom *argv)
 
         for (int i=0; i < N_CHANNELS; ++i) {
             post("signal outlet: %d", i);
+            mxd_stats_new(&x->stats, (t_object *)x);  // rightmost outlet: stats
             outlet_new(x, "signal");        // signal outlet (note "signal" rather than NULL)
         }
         
-        x->rev = new daisysp::ReverbSc;
+        x->rev = new daisysp::ReverbScT<MXD_SAMPLE_T>;
         x->feedback = 100.0;
         x->lp_freq = 0.5;
     }
@@ -80,6 +93,7 @@ void mxd_free(t_mxd *x)
 {
     delete x->rev;
     dsp_free((t_pxobject *)x);
+    mxd_stats_free(&x->stats);
 }
 
 
@@ -121,12 +135,16 @@ void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long
 
     x->rev->Init(samplerate);
 
+    mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);
+
     object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64, 0, NULL);
 }
 
 
 void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
 {
+    daisysp::ScopedFlushDenormals ftz;  // FTZ/DAZ for the duration of the vector
+    mxd_stats_scope timer(&x->stats);  // timed until perform returns
     t_double *inL = ins[0];     // we get audio for each inlet of the object from the **ins argument
     t_double *inR = ins[1];     // we get audio for each inlet of the object from the **ins argument
     t_double *outL = outs[0];   // we get audio for each outlet of the object from the **outs argument
@@ -135,16 +153,23 @@ void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double
     int n = sampleframes;       // n = 64
     x->rev->SetFeedback(x->feedback);
     x->rev->SetLpFreq(x->lp_freq);
-    float in_left;
-    float in_right;
-    float out_left;
-    float out_right;
+
+    // an idle reverb fed zeros would only render zeros
+    if (x->rev->IsSilent() && mxd_vector_is_silent(inL, n) && mxd_vector_is_silent(inR, n)) {
+        for (long i = 0; i < n; ++i) {
+            outL[i] = outR[i] = 0.0;
+        }
+        return;
+    }
+    MXD_SAMPLE_T in_left;
+    MXD_SAMPLE_T in_right;
+    MXD_SAMPLE_T out_left;
+    MXD_SAMPLE_T out_right;
 
     while (n--) {
-        in_left = *inL++;
-        in_right = *inR++;
+        in_left = (MXD_SAMPLE_T)*inL++;
+        in_right = (MXD_SAMPLE_T)*inR++;
         x->rev->Process(in_left, in_right, &out_left, &out_right);
-        // x->rev->Process(const float &in1, const float &in2, float *out1, float *out2);
         *outL++ = (t_double)out_left;
         *outR++ = (t_double)out_right;
     }
@@ -0,0 +1,198 @@
+/**
+    @file
+    mc.dsp.moog~: multichannel daisy_sp moog ladder filter bank
+*/
+#include "multimoogladder.h"
+#include "denormal.h"
+#include <cstdlib>
+
+#include "ext.h"
+#include "ext_obex.h"
+#include "z_dsp.h"
+
+#include "mxd_lists.h"
+#include "mxd_stats.h"
+
+#define MAX_CHANNELS 64
+
+
+typedef struct _mxd {
+    t_pxobject ob;                                      // the object itself (t_pxobject in MSP instead of t_object)
+    daisysp::MultiMoogLadder<MAX_CHANNELS>* filter;     // daisy SoA moog ladder bank
+    long chans;                                         // number of channels, follows the input
+    double freq[MAX_CHANNELS];                          // per-channel cutoff frequency in Hz
+    double res[MAX_CHANNELS];                           // per-channel resonance
+    bool dirty;                                         // parameters changed since last perform
+    float* buffers;                                     // float scratch, chans * maxvectorsize
+    float* channels[MAX_CHANNELS];                      // per-channel pointers into buffers
+    t_mxd_stats stats;          // perform64 timing, see mxd_stats.h
+} t_mxd;
+
+
+// method prototypes
+void *mxd_new(t_symbol *s, long argc, t_atom *argv);
+void mxd_free(t_mxd *x);
+void mxd_assist(t_mxd *x, void *b, long m, long a, char *s);
+void mxd_anything(t_mxd* x, t_symbol* s, long argc, t_atom* argv);
+long mxd_multichanneloutputs(t_mxd *x, long index);
+long mxd_inputchanged(t_mxd *x, long index, long count);
+void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags);
+void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam);
+
+
+// global class pointer variable
+static t_class *mxd_class = NULL;
+
+
+//-----------------------------------------------------------------------------------------------
+
+void ext_main(void *r)
+{
+    t_class *c = class_new("mc.dsp.moog~", (method)mxd_new, (method)mxd_free, (long)sizeof(t_mxd), 0L, A_GIMME, 0);
+
+    class_addmethod(c, (method)mxd_anything, "anything", A_GIMME,   0);
+    class_addmethod(c, (method)mxd_dsp64,    "dsp64",    A_CANT,    0);
+    class_addmethod(c, (method)mxd_assist,   "assist",   A_CANT,    0);
+    class_addmethod(c, (method)mxd_multichanneloutputs, "multichanneloutputs", A_CANT, 0);
+    class_addmethod(c, (method)mxd_inputchanged,        "inputchanged",        A_CANT, 0);
+    mxd_stats_setup<t_mxd>(c);
+
+    class_dspinit(c);
+    class_register(CLASS_BOX, c);
+    mxd_class = c;
+}
+
+void *mxd_new(t_symbol *s, long argc, t_atom *argv)
+{
+    t_mxd *x = (t_mxd *)object_alloc(mxd_class);
+
+    if (x) {
+        dsp_setup((t_pxobject *)x, 1);
+        x->ob.z_misc |= Z_MC_INLETS | Z_NO_INPLACE;
+        mxd_stats_new(&x->stats, (t_object *)x);  // rightmost outlet: stats
+        outlet_new(x, "multichannelsignal");
+
+        x->chans = 1;
+        x->filter = new daisysp::MultiMoogLadder<MAX_CHANNELS>;
+        for (int i = 0; i < MAX_CHANNELS; ++i) {
+            x->freq[i] = 100.0;
+            x->res[i] = 0.5;
+        }
+        x->dirty = true;
+        x->buffers = NULL;
+    }
+    return (x);
+}
+
+
+void mxd_free(t_mxd *x)
+{
+    dsp_free((t_pxobject *)x);
+    mxd_stats_free(&x->stats);
+    delete x->filter;
+    if (x->buffers) {
+        sysmem_freeptr(x->buffers);
+    }
+}
+
+
+void mxd_assist(t_mxd *x, void *b, long m, long a, char *s)
+{
+    if (m == ASSIST_INLET) {
+        sprintf(s, "(multichannel signal) input, freq and res (lists set channels in order)");
+    }
+    else {
+        sprintf(s, "(multichannel signal) %ld filtered channels", x->chans);
+    }
+}
+
+
+void mxd_anything(t_mxd* x, t_symbol* s, long argc, t_atom* argv)
+{
+    if (s != gensym("") && argc > 0) {
+        if (s == gensym("freq")) {
+            mxd_setlist(x->freq, MAX_CHANNELS, argc, argv);
+            x->dirty = true;
+        }
+        else if (s == gensym("res")) {
+            mxd_setlist(x->res, MAX_CHANNELS, argc, argv);
+            x->dirty = true;
+        }
+    }
+}
+
+
+long mxd_multichanneloutputs(t_mxd *x, long index)
+{
+    return x->chans;
+}
+
+
+long mxd_inputchanged(t_mxd *x, long index, long count)
+{
+    if (count > MAX_CHANNELS) {
+        count = MAX_CHANNELS;
+    }
+    if (count != x->chans) {
+        x->chans = count;
+        return true;
+    }
+    return false;
+}
+
+
+void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags)
+{
+    x->filter->Init(samplerate);
+    x->filter->SetNumChannels(x->chans);
+    x->dirty = true;
+
+    if (x->buffers) {
+        sysmem_freeptr(x->buffers);
+    }
+    x->buffers = (float *)sysmem_newptrclear(sizeof(float) * x->chans * maxvectorsize);
+    for (long i = 0; i < x->chans; ++i) {
+        x->channels[i] = x->buffers + i * maxvectorsize;
+    }
+
+    mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);
+
+    object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64, 0, NULL);
+}
+
+
+void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
+{
+    daisysp::ScopedFlushDenormals ftz;  // FTZ/DAZ for the duration of the vector
+    mxd_stats_scope timer(&x->stats);  // timed until perform returns
+    long chans = x->chans;
+    if (numins < chans) chans = numins;
+    if (numouts < chans) chans = numouts;
+
+    if (x->dirty) {
+        x->dirty = false;
+        for (long i = 0; i < chans; ++i) {
+            x->filter->SetFreq(i, x->freq[i]);
+            x->filter->SetRes(i, x->res[i]);
+        }
+    }
+
+    for (long i = 0; i < chans; ++i) {
+        t_double *in = ins[i];
+        float *dst = x->channels[i];
+        for (long n = 0; n < sampleframes; ++n) {
+            dst[n] = in[n];
+        }
+    }
+
+    // filter all channels in place, each ladder stage runs across channels
+    x->filter->ProcessBlock(x->channels, x->channels, sampleframes);
+
+    for (long i = 0; i < chans; ++i) {
+        t_double *out = outs[i];
+        float *src = x->channels[i];
+        for (long n = 0; n < sampleframes; ++n) {
+            out[n] = src[n];
+        }
+    }
+}
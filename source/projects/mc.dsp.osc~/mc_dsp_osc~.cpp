@@ -0,0 +1,214 @@
+/**
+    @file
+    mc.dsp.osc~: multichannel daisy_sp oscillator bank for Max
+*/
+#include "multioscillator.h"
+#include "denormal.h"
+#include <cstdlib>
+
+#include "ext.h"
+#include "ext_obex.h"
+#include "z_dsp.h"
+
+#include "mxd_lists.h"
+#include "mxd_stats.h"
+
+#define MAX_CHANNELS 64
+
+
+typedef struct _mxd {
+    t_pxobject ob;                                      // the object itself (t_pxobject in MSP instead of t_object)
+    daisysp::MultiOscillator<MAX_CHANNELS>* osc;        // daisy SoA oscillator bank
+    long chans;                                         // number of output channels
+    double freq[MAX_CHANNELS];                          // per-channel frequency in Hz
+    double amp[MAX_CHANNELS];                           // per-channel amplitude
+    double pulse_width[MAX_CHANNELS];                   // per-channel pulse width (range 0 - 1)
+    double phase[MAX_CHANNELS];                         // per-channel phase offset added once (range 0 - 1)
+    int waveform;                                       // waveform shared by all channels
+    bool dirty;                                         // parameters changed since last perform
+    float* buffers;                                     // float scratch, chans * maxvectorsize
+    float* outputs[MAX_CHANNELS];                       // per-channel pointers into buffers
+    t_mxd_stats stats;          // perform64 timing, see mxd_stats.h
+} t_mxd;
+
+
+// method prototypes
+void *mxd_new(t_symbol *s, long argc, t_atom *argv);
+void mxd_free(t_mxd *x);
+void mxd_assist(t_mxd *x, void *b, long m, long a, char *s);
+void mxd_anything(t_mxd* x, t_symbol* s, long argc, t_atom* argv);
+void mxd_float(t_mxd *x, double f);
+void mxd_int(t_mxd *x, long i);
+long mxd_multichanneloutputs(t_mxd *x, long index);
+void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags);
+void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam);
+
+
+// global class pointer variable
+static t_class *mxd_class = NULL;
+
+
+//-----------------------------------------------------------------------------------------------
+
+void ext_main(void *r)
+{
+    t_class *c = class_new("mc.dsp.osc~", (method)mxd_new, (method)mxd_free, (long)sizeof(t_mxd), 0L, A_GIMME, 0);
+
+    class_addmethod(c, (method)mxd_float,    "float",    A_FLOAT,   0);
+    class_addmethod(c, (method)mxd_int,      "int",      A_LONG,    0);
+    class_addmethod(c, (method)mxd_anything, "anything", A_GIMME,   0);
+    class_addmethod(c, (method)mxd_dsp64,    "dsp64",    A_CANT,    0);
+    class_addmethod(c, (method)mxd_assist,   "assist",   A_CANT,    0);
+    class_addmethod(c, (method)mxd_multichanneloutputs, "multichanneloutputs", A_CANT, 0);
+    mxd_stats_setup<t_mxd>(c);
+
+    class_dspinit(c);
+    class_register(CLASS_BOX, c);
+    mxd_class = c;
+}
+
+void *mxd_new(t_symbol *s, long argc, t_atom *argv)
+{
+    t_mxd *x = (t_mxd *)object_alloc(mxd_class);
+
+    if (x) {
+        dsp_setup((t_pxobject *)x, 1);
+        mxd_stats_new(&x->stats, (t_object *)x);  // rightmost outlet: stats
+        outlet_new(x, "multichannelsignal");
+
+        // first argument is the number of channels
+        x->chans = argc > 0 ? atom_getlong(argv) : 1;
+        if (x->chans < 1) x->chans = 1;
+        if (x->chans > MAX_CHANNELS) x->chans = MAX_CHANNELS;
+
+        x->osc = new daisysp::MultiOscillator<MAX_CHANNELS>;
+        for (int i = 0; i < MAX_CHANNELS; ++i) {
+            x->freq[i] = 100.0;
+            x->amp[i] = 0.5;
+            x->pulse_width[i] = 0.5;
+            x->phase[i] = 0.0;
+        }
+        x->waveform = daisysp::Oscillator::WAVE_SIN;
+        x->dirty = true;
+        x->buffers = NULL;
+    }
+    return (x);
+}
+
+
+void mxd_free(t_mxd *x)
+{
+    dsp_free((t_pxobject *)x);
+    mxd_stats_free(&x->stats);
+    delete x->osc;
+    if (x->buffers) {
+        sysmem_freeptr(x->buffers);
+    }
+}
+
+
+void mxd_assist(t_mxd *x, void *b, long m, long a, char *s)
+{
+    if (m == ASSIST_INLET) {
+        sprintf(s, "freq, amp, pw, phase (lists set channels in order), int sets waveform");
+    }
+    else {
+        sprintf(s, "(multichannel signal) %ld oscillators", x->chans);
+    }
+}
+
+
+void mxd_anything(t_mxd* x, t_symbol* s, long argc, t_atom* argv)
+{
+    if (s != gensym("") && argc > 0) {
+        if (s == gensym("freq")) {
+            mxd_setlist(x->freq, MAX_CHANNELS, argc, argv);
+            x->dirty = true;
+        }
+        else if (s == gensym("amp")) {
+            mxd_setlist(x->amp, MAX_CHANNELS, argc, argv);
+            x->dirty = true;
+        }
+        else if (s == gensym("pw")) {
+            mxd_setlist(x->pulse_width, MAX_CHANNELS, argc, argv);
+            x->dirty = true;
+        }
+        else if (s == gensym("phase")) {
+            mxd_setlist(x->phase, MAX_CHANNELS, argc, argv);
+            x->dirty = true;
+        }
+    }
+}
+
+
+void mxd_float(t_mxd *x, double f)
+{
+    t_atom a;
+    atom_setfloat(&a, f);
+    mxd_setlist(x->freq, MAX_CHANNELS, 1, &a);
+    x->dirty = true;
+}
+
+
+void mxd_int(t_mxd *x, long i)
+{
+    x->waveform = (int)i;
+    x->dirty = true;
+}
+
+
+long mxd_multichanneloutputs(t_mxd *x, long index)
+{
+    return x->chans;
+}
+
+
+void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags)
+{
+    x->osc->Init(samplerate);
+    x->osc->SetNumChannels(x->chans);
+    x->dirty = true;
+
+    if (x->buffers) {
+        sysmem_freeptr(x->buffers);
+    }
+    x->buffers = (float *)sysmem_newptrclear(sizeof(float) * x->chans * maxvectorsize);
+    for (long i = 0; i < x->chans; ++i) {
+        x->outputs[i] = x->buffers + i * maxvectorsize;
+    }
+
+    mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);
+
+    object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64, 0, NULL);
+}
+
+
+void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
+{
+    daisysp::ScopedFlushDenormals ftz;  // FTZ/DAZ for the duration of the vector
+    mxd_stats_scope timer(&x->stats);  // timed until perform returns
+    long chans = numouts < x->chans ? numouts : x->chans;
+
+    if (x->dirty) {
+        x->dirty = false;
+        x->osc->SetWaveform(x->waveform);
+        for (long i = 0; i < chans; ++i) {
+            x->osc->SetFreq(i, x->freq[i]);
+            x->osc->SetAmp(i, x->amp[i]);
+            x->osc->SetPw(i, x->pulse_width[i]);
+            x->osc->PhaseAdd(i, x->phase[i]);
+            x->phase[i] = 0.0;
+        }
+    }
+
+    // all channels advance together in the bank, then widen to double
+    x->osc->ProcessBlock(x->outputs, sampleframes);
+
+    for (long i = 0; i < chans; ++i) {
+        t_double *out = outs[i];
+        float *src = x->outputs[i];
+        for (long n = 0; n < sampleframes; ++n) {
+            out[n] = src[n];
+        }
+    }
+}
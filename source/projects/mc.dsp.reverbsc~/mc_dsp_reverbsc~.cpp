@@ -0,0 +1,201 @@
+/**
+    @file
+    mc.dsp.reverbsc~: multichannel daisy_sp stereo reverb, one reverb per channel pair
+*/
+#include "reverbsc.h"
+#include "denormal.h"
+#include <cstdlib>
+
+#include "ext.h"
+#include "ext_obex.h"
+#include "z_dsp.h"
+
+#include "mxd_silence.h"
+#include "mxd_stats.h"
+
+#define MAX_CHANNELS 64
+
+// DaisySP sample type: double runs the reverbs natively on Max's 64-bit
+// signal vectors, build with -DMXD_SAMPLE_T=float for the float path
+#ifndef MXD_SAMPLE_T
+#define MXD_SAMPLE_T double
+#endif
+
+
+typedef struct _mxd {
+    t_pxobject ob;              // the object itself (t_pxobject in MSP instead of t_object)
+    daisysp::ReverbScT<MXD_SAMPLE_T>* revs;    // one daisy reverb per channel pair, allocated together
+    long num_revs;              // number of allocated reverbs
+    long chans;                 // number of channels, follows the input
+    double feedback;            // controls the reverb time, reverb tail becomes infinite when set to 1.0 (range 0.0 to 1.0)
+    double lp_freq;             // controls the internal dampening filter's cutoff frequency. (range: 0.0 to sample_rate / 2)
+    t_mxd_stats stats;          // perform64 timing, see mxd_stats.h
+} t_mxd;
+
+
+// method prototypes
+void *mxd_new(t_symbol *s, long argc, t_atom *argv);
+void mxd_free(t_mxd *x);
+void mxd_assist(t_mxd *x, void *b, long m, long a, char *s);
+void mxd_anything(t_mxd* x, t_symbol* s, long argc, t_atom* argv);
+long mxd_multichanneloutputs(t_mxd *x, long index);
+long mxd_inputchanged(t_mxd *x, long index, long count);
+void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags);
+void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam);
+
+
+// global class pointer variable
+static t_class *mxd_class = NULL;
+
+
+//-----------------------------------------------------------------------------------------------
+
+void ext_main(void *r)
+{
+    t_class *c = class_new("mc.dsp.reverbsc~", (method)mxd_new, (method)mxd_free, (long)sizeof(t_mxd), 0L, A_GIMME, 0);
+
+    class_addmethod(c, (method)mxd_anything, "anything", A_GIMME,   0);
+    class_addmethod(c, (method)mxd_dsp64,    "dsp64",    A_CANT,    0);
+    class_addmethod(c, (method)mxd_assist,   "assist",   A_CANT,    0);
+    class_addmethod(c, (method)mxd_multichanneloutputs, "multichanneloutputs", A_CANT, 0);
+    class_addmethod(c, (method)mxd_inputchanged,        "inputchanged",        A_CANT, 0);
+    mxd_stats_setup<t_mxd>(c);
+
+    class_dspinit(c);
+    class_register(CLASS_BOX, c);
+    mxd_class = c;
+}
+
+void *mxd_new(t_symbol *s, long argc, t_atom *argv)
+{
+    t_mxd *x = (t_mxd *)object_alloc(mxd_class);
+
+    if (x) {
+        dsp_setup((t_pxobject *)x, 1);
+        x->ob.z_misc |= Z_MC_INLETS;
+        mxd_stats_new(&x->stats, (t_object *)x);  // rightmost outlet: stats
+        outlet_new(x, "multichannelsignal");
+
+        x->revs = NULL;
+        x->num_revs = 0;
+        x->chans = 2;
+        x->feedback = 0.97;
+        x->lp_freq = 10000.0;
+    }
+    return (x);
+}
+
+
+void mxd_free(t_mxd *x)
+{
+    dsp_free((t_pxobject *)x);
+    mxd_stats_free(&x->stats);
+    delete[] x->revs;
+}
+
+
+void mxd_assist(t_mxd *x, void *b, long m, long a, char *s)
+{
+    if (m == ASSIST_INLET) {
+        sprintf(s, "(multichannel signal) input, channels 1+2, 3+4, ... share a reverb");
+    }
+    else {
+        sprintf(s, "(multichannel signal) %ld reverberated channels", x->chans);
+    }
+}
+
+
+void mxd_anything(t_mxd* x, t_symbol* s, long argc, t_atom* argv)
+{
+    if (s != gensym("") && argc > 0) {
+        if (s == gensym("feedback")) {
+            x->feedback = atom_getfloat(argv);
+        }
+        else if (s == gensym("lp_freq")) {
+            x->lp_freq = atom_getfloat(argv);
+        }
+    }
+}
+
+
+long mxd_multichanneloutputs(t_mxd *x, long index)
+{
+    return x->chans;
+}
+
+
+long mxd_inputchanged(t_mxd *x, long index, long count)
+{
+    if (count > MAX_CHANNELS) {
+        count = MAX_CHANNELS;
+    }
+    if (count != x->chans) {
+        x->chans = count;
+        return true;
+    }
+    return false;
+}
+
+
+void mxd_dsp64(t_mxd *x, t_object *dsp64, short *count, double samplerate, long maxvectorsize, long flags)
+{
+    // each reverb carries a large delay memory, only grow the set when needed
+    long pairs = (x->chans + 1) / 2;
+    if (pairs > x->num_revs) {
+        delete[] x->revs;
+        x->revs = new daisysp::ReverbScT<MXD_SAMPLE_T>[pairs];
+        x->num_revs = pairs;
+    }
+    for (long i = 0; i < pairs; ++i) {
+        x->revs[i].Init(samplerate);
+    }
+
+    mxd_stats_dsp(&x->stats, samplerate, maxvectorsize);
+
+    object_method(dsp64, gensym("dsp_add64"), x, mxd_perform64, 0, NULL);
+}
+
+
+void mxd_perform64(t_mxd *x, t_object *dsp64, double **ins, long numins, double **outs, long numouts, long sampleframes, long flags, void *userparam)
+{
+    daisysp::ScopedFlushDenormals ftz;  // FTZ/DAZ for the duration of the vector
+    mxd_stats_scope timer(&x->stats);  // timed until perform returns
+    long chans = x->chans;
+    if (numins < chans) chans = numins;
+    if (numouts < chans) chans = numouts;
+
+    MXD_SAMPLE_T out_left;
+    MXD_SAMPLE_T out_right;
+
+    for (long c = 0; c < chans; c += 2) {
+        daisysp::ReverbScT<MXD_SAMPLE_T> *rev = &x->revs[c / 2];
+        rev->SetFeedback(x->feedback);
+        rev->SetLpFreq(x->lp_freq);
+
+        // an odd last channel feeds both reverb inputs and keeps the left output
+        bool pair = (c + 1) < chans;
+        t_double *inL = ins[c];
+        t_double *inR = pair ? ins[c + 1] : ins[c];
+        t_double *outL = outs[c];
+        t_double *outR = pair ? outs[c + 1] : NULL;
+
+        // an idle reverb fed zeros would only render zeros
+        if (rev->IsSilent() && mxd_vector_is_silent(inL, sampleframes) && mxd_vector_is_silent(inR, sampleframes)) {
+            for (long n = 0; n < sampleframes; ++n) {
+                outL[n] = 0.0;
+                if (outR) {
+                    outR[n] = 0.0;
+                }
+            }
+            continue;
+        }
+
+        for (long n = 0; n < sampleframes; ++n) {
+            rev->Process((MXD_SAMPLE_T)inL[n], (MXD_SAMPLE_T)inR[n], &out_left, &out_right);
+            outL[n] = out_left;
+            if (outR) {
+                outR[n] = out_right;
+            }
+        }
+    }
+}